@@ -1,6 +1,7 @@
 #ifndef ACTIONSTATS_H
 #define ACTIONSTATS_H
 
+#include <algorithm>
 #include <cmath>
 struct ActionStats {
     int handsPlayed = 0;  // number of hands
@@ -34,6 +35,34 @@ struct ActionStats {
     //     addResult(-loss, loss);
     // }
 
+    // Combine another accumulator into this one (weights are totalMoneyWagered)
+    void merge(const ActionStats& src) {
+        splitsPlayed += src.splitsPlayed;
+        totalPayout += src.totalPayout;
+        handsPlayed += src.handsPlayed;
+
+        const double dstWeight = totalMoneyWagered;
+        const double srcWeight = src.totalMoneyWagered;
+
+        if (srcWeight <= 0.0) {
+            return;
+        }
+
+        if (dstWeight <= 0.0) {
+            totalMoneyWagered = srcWeight;
+            mean = src.mean;
+            M2 = src.M2;
+            return;
+        }
+
+        const double totalWeight = dstWeight + srcWeight;
+        const double delta = src.mean - mean;
+
+        mean = (dstWeight * mean + srcWeight * src.mean) / totalWeight;
+        M2 = M2 + src.M2 + delta * delta * dstWeight * srcWeight / totalWeight;
+        totalMoneyWagered = totalWeight;
+    }
+
     void timesSplit() {
         splitsPlayed++;
     }
@@ -60,6 +89,65 @@ struct ActionStats {
     }
 };
 
+// Outcomes of two actions rolled out from the same cards, one pair per
+// occurrence. The shared cards make the outcomes covary, so the variance of
+// their difference, varA + varB - 2 cov, is far below varA + varB.
+struct PairedStats {
+    int pairs = 0;
+    double meanA = 0.0;
+    double meanB = 0.0;
+    double M2A = 0.0;
+    double M2B = 0.0;
+    double C = 0.0;                 // running co-moment of A and B
+
+    void addPair(double a, double b) {
+        ++pairs;
+        const double deltaA = a - meanA;
+        const double deltaB = b - meanB;
+        meanA += deltaA / pairs;
+        meanB += deltaB / pairs;
+        M2A += deltaA * (a - meanA);
+        M2B += deltaB * (b - meanB);
+        C += deltaA * (b - meanB);
+    }
+
+    void merge(const PairedStats& src) {
+        if (src.pairs == 0) {
+            return;
+        }
+        if (pairs == 0) {
+            *this = src;
+            return;
+        }
+        const double total = static_cast<double>(pairs) + src.pairs;
+        const double deltaA = src.meanA - meanA;
+        const double deltaB = src.meanB - meanB;
+        const double weight = static_cast<double>(pairs) * src.pairs / total;
+        meanA += deltaA * src.pairs / total;
+        meanB += deltaB * src.pairs / total;
+        M2A += src.M2A + deltaA * deltaA * weight;
+        M2B += src.M2B + deltaB * deltaB * weight;
+        C += src.C + deltaA * deltaB * weight;
+        pairs += src.pairs;
+    }
+
+    // EV of the first action minus the second
+    double getDiffEV() const {
+        return meanA - meanB;
+    }
+
+    double getCovariance() const {
+        return pairs > 0 ? C / pairs : 0.0;
+    }
+
+    double getDiffVariance() const {
+        return pairs > 0 ? (M2A + M2B - 2.0 * C) / pairs : 0.0;   // population variance
+    }
+
+    double getDiffStdError() const {
+        return pairs > 0 ? std::sqrt(std::max(getDiffVariance(), 0.0) / pairs) : 0.0;
+    }
+};
 
 struct DecisionPoint {
     ActionStats hitStats;
@@ -69,6 +157,19 @@ struct DecisionPoint {
     ActionStats surrenderStats;
     ActionStats insuranceAcceptStats;
     ActionStats insuranceDeclineStats;
+    // First of the scenario's actions against its second, same cards
+    PairedStats pairedStats;
+
+    void merge(const DecisionPoint& src) {
+        hitStats.merge(src.hitStats);
+        standStats.merge(src.standStats);
+        doubleStats.merge(src.doubleStats);
+        splitStats.merge(src.splitStats);
+        surrenderStats.merge(src.surrenderStats);
+        insuranceAcceptStats.merge(src.insuranceAcceptStats);
+        insuranceDeclineStats.merge(src.insuranceDeclineStats);
+        pairedStats.merge(src.pairedStats);
+    }
 };
 
 #endif // ACTIONSTATS_H
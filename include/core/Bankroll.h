@@ -5,17 +5,17 @@ class Bankroll {
 private:
     double balance;
     double totalMoneyBet;
-    static double initialBalance;
 public:
 
     Bankroll(double startBalance = 0);
+    // Start over at `startBalance` with nothing wagered.
+    void reset(double startBalance);
     
     void deposit(double amount);
     void withdraw(double amount);
     
     double getBalance() const;
     double getTotalMoneyBet() const;
-    static double getInitialBalance();
     
     void addTotalBet(double amount);
 };
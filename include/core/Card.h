@@ -1,20 +1,43 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include <array>
+#include <cstdint>
 #include "rank.h"
 #include "suit.h"
 
+// Per-rank properties, indexed by static_cast<int>(Rank).
+namespace CardTables {
+    // Ace is initially worth 11, can be adjusted in Hand class
+    inline constexpr std::array<std::int8_t, 13> VALUE = {2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 11};
+    inline constexpr std::array<bool, 13> IS_TEN = {false, false, false, false, false, false, false, false, true, true, true, true, false};
+    inline constexpr std::array<bool, 13> IS_ACE = {false, false, false, false, false, false, false, false, false, false, false, false, true};
+}
+
+// One byte per card: rank in the low nibble, suit in bits 4-5. getCode() is a
+// dense index (< CODE_COUNT) for per-card lookup tables such as count tags.
 class Card{
     private:
-        Rank rank_;
-        Suit suit_;
+        std::uint8_t code_;
     public:
-        Card(Rank rank, Suit suit);
-        Rank getRank() const;
-        Suit getSuit() const ;
-        bool isWorthTen();
-        bool isAce();
-        int getValue() const;
+        static constexpr int CODE_COUNT = 64;
+        static constexpr std::uint8_t RANK_MASK = 0x0F;
+        static constexpr int SUIT_SHIFT = 4;
+
+        // Placeholder (Two of Spades) so cards can sit in fixed-size arrays.
+        constexpr Card() : code_(0) {}
+        constexpr Card(Rank rank, Suit suit)
+            : code_(static_cast<std::uint8_t>(static_cast<std::uint8_t>(rank) | (static_cast<std::uint8_t>(suit) << SUIT_SHIFT))) {}
+
+        constexpr Rank getRank() const { return static_cast<Rank>(code_ & RANK_MASK); }
+        constexpr Suit getSuit() const { return static_cast<Suit>(code_ >> SUIT_SHIFT); }
+        constexpr std::uint8_t getCode() const { return code_; }
+
+        constexpr bool isWorthTen() const { return CardTables::IS_TEN[code_ & RANK_MASK]; }
+        constexpr bool isAce() const { return CardTables::IS_ACE[code_ & RANK_MASK]; }
+        constexpr int getValue() const { return CardTables::VALUE[code_ & RANK_MASK]; }
 };
 
+static_assert(sizeof(Card) == 1, "Card must stay packed into one byte");
+
 #endif
@@ -0,0 +1,109 @@
+#ifndef DEALERKERNEL_H
+#define DEALERKERNEL_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "Card.h"
+#include "Hand.h"
+
+namespace DealerTables {
+    // Hard totals run to 26 (hard 16 plus a ten); larger values are clamped.
+    constexpr int MAX_HARD = 31;
+    constexpr int STATE_COUNT = (MAX_HARD + 1) * 2;
+
+    constexpr int encode(int hardTotal, bool hasAce) {
+        return (hardTotal > MAX_HARD ? MAX_HARD : hardTotal) * 2 + (hasAce ? 1 : 0);
+    }
+
+    constexpr std::array<bool, STATE_COUNT> buildStops(bool hitSoft17) {
+        std::array<bool, STATE_COUNT> table{};
+        for (int hard = 0; hard <= MAX_HARD; ++hard) {
+            for (int ace = 0; ace < 2; ++ace) {
+                const bool soft = ace && hard + 10 <= 21;
+                const int score = soft ? hard + 10 : hard;
+                table[encode(hard, ace)] = score > 17 || (score == 17 && !(soft && hitSoft17));
+            }
+        }
+        return table;
+    }
+
+    constexpr std::array<std::array<std::uint8_t, 13>, STATE_COUNT> buildNext() {
+        std::array<std::array<std::uint8_t, 13>, STATE_COUNT> table{};
+        for (int hard = 0; hard <= MAX_HARD; ++hard) {
+            for (int ace = 0; ace < 2; ++ace) {
+                for (int rank = 0; rank < 13; ++rank) {
+                    const bool isAce = CardTables::IS_ACE[rank];
+                    const int value = isAce ? 1 : CardTables::VALUE[rank];
+                    table[encode(hard, ace)][rank] = static_cast<std::uint8_t>(encode(hard + value, ace || isAce));
+                }
+            }
+        }
+        return table;
+    }
+
+    inline constexpr std::array<bool, STATE_COUNT> STOPS_H17 = buildStops(true);
+    inline constexpr std::array<bool, STATE_COUNT> STOPS_S17 = buildStops(false);
+    inline constexpr std::array<std::array<std::uint8_t, 13>, STATE_COUNT> NEXT = buildNext();
+}
+
+// Dealer play as a compile-time state machine. A state is (hard total with
+// aces as 1, holds an ace); NEXT gives the state after drawing a rank and
+// STOPS says whether the dealer stands there under H17 or S17 rules.
+class DealerKernel {
+    public:
+        static constexpr int STATE_COUNT = DealerTables::STATE_COUNT;
+
+        static constexpr int encode(int hardTotal, bool hasAce) {
+            return DealerTables::encode(hardTotal, hasAce);
+        }
+        static int stateOf(const Hand& dealer) {
+            return encode(dealer.getHardTotal(), dealer.hasAce());
+        }
+
+        template <bool HitSoft17>
+        static constexpr bool stops(int state) {
+            return HitSoft17 ? DealerTables::STOPS_H17[state] : DealerTables::STOPS_S17[state];
+        }
+        static constexpr int next(int state, Rank rank) {
+            return DealerTables::NEXT[state][static_cast<int>(rank)];
+        }
+
+        // Draw for the dealer until the rules say stand. `draw` returns
+        // std::optional<Card>; `onCard` sees each card after it joins the hand.
+        // Returns false if `draw` ran dry first.
+        template <bool HitSoft17, class DrawFn, class CardFn>
+        static bool play(Hand& dealer, DrawFn&& draw, CardFn&& onCard) {
+            int state = stateOf(dealer);
+            while (!stops<HitSoft17>(state)) {
+                std::optional<Card> card = draw();
+                if (!card) {
+                    return false;
+                }
+                dealer.addCard(*card);
+                onCard(*card);
+                state = next(state, card->getRank());
+            }
+            return true;
+        }
+
+        template <class DrawFn, class CardFn>
+        static bool play(Hand& dealer, bool hitSoft17, DrawFn&& draw, CardFn&& onCard) {
+            return hitSoft17 ? play<true>(dealer, draw, onCard) : play<false>(dealer, draw, onCard);
+        }
+
+        // Resolve the dealer once for all of a player's (split) hands: the
+        // dealer only draws if at least one hand is still live.
+        template <class DrawFn, class CardFn>
+        static bool resolve(Hand& dealer, const std::vector<Hand>& hands, bool hitSoft17, DrawFn&& draw, CardFn&& onCard) {
+            for (const Hand& hand : hands) {
+                if (hand.getFinalScore() != 0) {
+                    return play(dealer, hitSoft17, draw, onCard);
+                }
+            }
+            return true;
+        }
+};
+
+#endif
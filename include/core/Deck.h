@@ -1,29 +1,82 @@
 #ifndef DECK_H
 #define DECK_H
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <random>
+#include <optional>
+#include <string>
 #include <vector>
 #include "Card.h"
+#include "ShoeRng.h"
+
+// Full shuffles the whole shoe up front. Lazy runs the same Fisher-Yates one
+// step per drawn card, so cards left behind the cut card are never touched.
+enum class ShuffleMode { Full, Lazy };
 
 class Deck{
     private:
         std::vector<Card> deck;
+        int numDecks = 0;
+        ShoeRng rng;
+        ShuffleMode mode = ShuffleMode::Full;
+        // Cards are dealt from deck[top - 1] downwards and never erased, so a
+        // position can be rewound. Slots at or above randomizedFrom are final.
+        std::size_t top = 0;
+        std::size_t randomizedFrom = 0;
+        // Composition of deck[0, top), kept up to date as cards are drawn
+        std::array<int, 13> rankCounts{};
+        int tenCount = 0;
+
+        static std::uint64_t getBaseSeed();
 
-        static std::mt19937& getGlobalRng();
+        void fillCanonical();
+        void recount();
+        void remove(Card card);
+        void randomize();
+        Card draw();
 
     public:
         static const int NUM_RANK = 13;
         static const int NUM_SUIT = 4;
         static const int NUM_CARDS_IN_DECK = 52;
 
-        Deck(int deck_size);
+        Deck(int deck_size, ShuffleMode mode = ShuffleMode::Full);
+        // Per-thread generator that seeds new shoes; reseeded by setSeed()/clearSeed().
+        static ShoeRng& getGlobalRng();
         static Deck createTestDeck(std::vector<Card> stackedCards);
+        // Throw std::runtime_error when the shoe runs out.
         std::pair<Card,Card> deal();
         Card hit();
+        // Same draws, but an exhausted shoe is reported as std::nullopt.
+        std::optional<std::pair<Card,Card>> tryDeal();
+        std::optional<Card> tryHit();
         int getSize();
+        ShuffleMode getShuffleMode() const;
+
+        // Remaining composition in O(1).
+        int remainingOfRank(Rank rank) const;
+        // Ten, Jack, Queen and King together.
+        int remainingTens() const;
+        // Fraction of the remaining cards worth ten; 0 for an empty shoe.
+        double tenDensity() const;
         Deck clone() const;
+
+        // Position in the shoe that rewind() can return to. Rolling out several
+        // actions from one decision is mark(), play, rewind(), play, ... and
+        // each rollout sees the same cards without copying the shoe.
+        using Mark = std::size_t;
+        Mark mark() const;
+        void rewind(Mark position);
+
+        // Refill the shoe and shuffle it from the next stream of this deck's generator.
         void reset();
+        // Refill the shoe and shuffle it from stream `shoeIndex` under `streamKey`.
+        // The result depends only on (streamKey, shoeIndex), so any shoe of a run can be
+        // regenerated directly and shoes can be split across threads or processes.
+        void resetForShoe(std::uint64_t streamKey, std::uint64_t shoeIndex);
+        // Stream key for a named run (usually the strategy name) under the current seed.
+        static std::uint64_t streamKey(const std::string& tag);
 
         // Set a deterministic RNG seed for reproducible shuffles.
         static void setSeed(std::uint32_t seed);
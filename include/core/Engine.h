@@ -1,6 +1,7 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include <cstdint>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -14,75 +15,166 @@
 #include "BasicStrategy.h"
 #include "observers/EventBus.h"
 #include "Player.h"
+#include "BotPlayer.h"
 #include "Bankroll.h"
 #include "GameReporter.h"
 #include "FixedEngine.h"
 #include "GameConfig.h"
+#include "ScenarioMatcher.h"
+#include "TrueCountHistogram.h"
 
 class Engine{
 
 public:
 
+    static constexpr int MAX_SEATS = 7;
+
     Engine(
         const GameConfig& gameConfig, //pass by reference to avoid copy
         Deck deck,
         Player* player,
         EventBus* eventBus, // not owned can be nullptr
         std::map<std::pair<int, int>, std::map<float, DecisionPoint>>& EVresults,
-        std::map<float,ActionStats>* EVperTC
+        TrueCountHistogram* EVperTC
     );
 
+    // A table of 1-7 seats, dealt in order from one shoe. Every seat counts
+    // every exposed card. EVperTC and Monte Carlo belong to seat 0.
+    Engine(
+        const GameConfig& gameConfig,
+        Deck deck,
+        const std::vector<Player*>& players,
+        EventBus* eventBus,
+        std::map<std::pair<int, int>, std::map<float, DecisionPoint>>& EVresults,
+        TrueCountHistogram* EVperTC
+    );
+
+    // Plays the shoe out; returns seat 0's {balance, money bet}.
     std::pair<double, double> runner();
     FixedEngine runnerMonte();
+    // {balance, money bet} for every seat, in seat order.
+    std::vector<std::pair<double, double>> getSeatResults() const;
+    const TrueCountHistogram& getSeatEVperTC(int seatIndex) const;
+
+    // Reuse this engine for another shoe: restore the starting wallet, reset
+    // the player's count and play either the engine's own deck reshuffled
+    // from its next stream (resetShoe) or a copy of `shoe` (loadShoe, which
+    // reuses the deck buffer). EV-per-TC and Monte Carlo results keep
+    // accumulating across shoes.
+    void resetShoe();
+    void loadShoe(const Deck& shoe);
+    // resetShoe() then runner(), n times; returns the summed {balance, money bet}.
+    std::pair<double, double> runShoes(std::uint64_t n);
+    const FixedEngine& getMonteCarloResults() const;
 
 private:
-    Bankroll bankroll;
     static constexpr double SURRENDERMULTIPLIER = .5;
     static constexpr double INSURANCEBETCOST = .5;
     GameConfig config;
 
+    // One player's chair and money; all seats share the shoe and the dealer.
+    struct Seat {
+        Seat(Player* player, BotPlayer* bot, MultiCountTracker* tracker, double wallet, TrueCountHistogram* EVperTC,
+             std::pair<float, float> trueCountRange)
+            : player(player), bot(bot), tracker(tracker), bankroll(wallet),
+              EVperTCStorage(trueCountRange.first, trueCountRange.second), EVperTC(EVperTC) {}
+
+        Player* player;
+        // Set when player is a BotPlayer: per-card and per-decision calls then go
+        // straight to its concrete strategy instead of through two vtables.
+        BotPlayer* bot;
+        // Set when the strategy is a MultiCountTracker, which also gets every result
+        MultiCountTracker* tracker;
+        Bankroll bankroll;
+        TrueCountHistogram EVperTCStorage;
+        TrueCountHistogram* EVperTC; // external table, or nullptr for EVperTCStorage
+        float handTrueCount = 0.0f;
+        int handBin = 0; // handTrueCount's bin in the seat's EV-per-TC table
+        double currentHandBetTotal = 0.0;
+        int bet = 0;
+        std::optional<Hand> user;
+        std::vector<Hand> hands;
+    };
+
     std::optional<Deck> deck;
-    Player* player;
+    std::vector<Seat> seats;
+    Seat* seat = nullptr; // the seat being dealt to or settled
+    bool holeCardCounted = false;
     GameReporter reporter;
 
     FixedEngine fixedEngine;
 
-    std::map<float,ActionStats> EVperTCStorage;
-    std::map<float,ActionStats>* EVperTC;
-    float handTrueCount = 0.0f;
-    double currentHandBetTotal = 0.0;
+    // Set when a draw finds the shoe empty; the round is then voided instead of unwound.
+    bool shoeExhausted = false;
+    // Derived from config once instead of rescanning it every hand
+    bool insuranceMonteCarlo = false;
+    // config.monteCarloScenarios compiled to a per-hand lookup
+    ScenarioMatcher scenarioMatcher;
+
+    // playHand specialised for this engine's rules and tracing (see RulesPolicy.h, TracePolicy.h)
+    using PlayHandFn = void (Engine::*)();
+    PlayHandFn playHandFn = nullptr;
+    static PlayHandFn selectPlayHand(const GameConfig& config);
+    template <class Trace> static PlayHandFn selectPlayHand(const GameConfig& config);
+    static bool isInsuranceMonteCarloActionSet(const GameConfig& config);
+
+    void countCard(Card card) {
+        for (Seat& s : seats) {
+            if (s.bot) s.bot->updateCount(card); else s.player->updateCount(card);
+        }
+    }
+    float playerTrueCount() {
+        return seat->bot ? seat->bot->getTrueCount() : seat->player->getTrueCount();
+    }
+    Action chooseAction(Hand& user, Hand& dealer, float trueCount) {
+        return seat->bot ? seat->bot->getAction(user, dealer, trueCount) : seat->player->getAction(user, dealer, trueCount);
+    }
+    static TrueCountHistogram& evTable(Seat& s) {
+        return s.EVperTC ? *s.EVperTC : s.EVperTCStorage;
+    }
+    void recordResult(double net, double wagered) {
+        evTable(*seat).bin(seat->handBin).addResult(net, wagered);
+        if (seat->tracker) seat->tracker->recordResult(net, wagered);
+    }
+    void revealHoleCard(Hand& dealer);
+    void placeBet();
+    std::optional<Hand> dealTable();
 
     //hand evaluation logic
     std::vector<int> getPlayerScores(std::vector<Hand>& hands);
     bool didHandsBust(std::vector<int> scores);
     bool didPlayerGetNaturalBlackjack(std::vector<Hand>& hands);
-    void NaturalBlackJackHandler(Hand& dealer, Hand& user);
-    void evaluateHands(Hand& dealer, std::vector<Hand>& hands);
+    static const char* outcomeLabel(int dealerScore, int playerScore);
+    template <class Trace> void NaturalBlackJackHandler(Hand& dealer, Hand& user);
+    template <class Rules, class Trace> void evaluateHands(Hand& dealer);
+    template <class Trace> void settleHands(Hand& dealer, std::vector<Hand>& hands);
     
     //hand play logic
-    std::vector<Hand> user_play(Hand& dealer, Hand& user);
-    void play_hand(Hand& dealer, Hand& user, std::vector<Hand>& hands, bool is_split_aces = false, bool has_split = false);
+    template <class Rules, class Trace> std::vector<Hand> user_play(Hand& dealer, Hand& user);
+    template <class Rules, class Trace> void play_hand(Hand& dealer, Hand& user, std::vector<Hand>& hands, bool is_split_aces = false, bool has_split = false);
 
     //card drawing logic
-    Hand draw_cards(int betSize = 0);
-    void dealer_draw(Hand& dealer, std::vector<Hand>& user);
+    std::optional<Hand> draw_cards(int betSize = 0);
+    std::optional<Card> drawCard();
+    template <class Rules, class Trace> void dealer_draw(Hand& dealer);
 
     //game logic
-    void playHand();
+    template <class Rules, class Trace> void playHand();
+    void abandonRound();
 
-    bool handleInsurancePhase(Hand& dealer, Hand& user);
+    template <class Trace> bool handleInsurancePhase(Hand& dealer, Hand& user);
     bool canOfferInsurance(Hand& dealer);
     bool askInsurance();
-    bool resolveInsurance(bool accepted, Hand& dealer, Hand& user);
-    bool handleInsuranceAccepted(Hand& dealer, Hand& user);
-    bool handleInsuranceDeclined(Hand& dealer, Hand& user);
-    bool dealerRobberyHandler(Hand& dealer,Hand& user);
-
-    bool standHandler(Hand& user, std::vector<Hand>& hands, std::string handLabel);
-    bool hitHandler(Hand& user, std::vector<Hand>& hands, std::string handLabel);
-    bool doubleHandler(Hand& user, std::vector<Hand>& hands, std::string handLabel,bool has_split);
-    bool splitHandler(Hand& user,Hand& dealer, std::vector<Hand>& hands, std::string handLabel,bool has_split, bool is_split_aces);
-    bool surrenderHandler(Hand& user, std::vector<Hand>& hands, std::string handLabel);
+    template <class Trace> bool resolveInsurance(bool accepted, Hand& dealer, Hand& user);
+    template <class Trace> bool handleInsuranceAccepted(Hand& dealer, Hand& user);
+    template <class Trace> bool handleInsuranceDeclined(Hand& dealer, Hand& user);
+    template <class Trace> bool dealerRobberyHandler(Hand& dealer,Hand& user);
+
+    template <class Trace> bool standHandler(Hand& user, std::vector<Hand>& hands, const char* handLabel);
+    template <class Trace> bool hitHandler(Hand& user, std::vector<Hand>& hands, const char* handLabel);
+    template <class Rules, class Trace> bool doubleHandler(Hand& user, std::vector<Hand>& hands, const char* handLabel,bool has_split);
+    template <class Rules, class Trace> bool splitHandler(Hand& user,Hand& dealer, std::vector<Hand>& hands, const char* handLabel,bool has_split, bool is_split_aces);
+    template <class Trace> bool surrenderHandler(Hand& user, std::vector<Hand>& hands, const char* handLabel);
 
     void playForcedHand(Hand& dealer, Hand& user, std::vector<Hand>& hands, bool is_split_aces, bool has_split, Action forcedAction);
     void calculateEV(Hand& dealer, Hand& user, std::vector<Hand>& hands, bool is_split_aces, bool has_split, Action forcedAction, float trueCount);
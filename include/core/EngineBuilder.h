@@ -11,7 +11,7 @@ class EngineBuilder {
         std::optional<Deck> deck;
         EventBus* eventBus = nullptr;
         std::map<std::pair<int, int>, std::map<float, DecisionPoint>> EVresults;
-        std::map<float,ActionStats>* EVperTC = nullptr;
+        TrueCountHistogram* EVperTC = nullptr;
 
     public:
         EngineBuilder& setDeckSize(int deck_size);
@@ -54,8 +54,12 @@ class EngineBuilder {
         EngineBuilder& addMonteCarloScenario(const MonteCarloScenario& scenario);
         EngineBuilder& setMonteCarloScenarios(const std::vector<MonteCarloScenario>& scenarios);
 
-        EngineBuilder& setEVperTC(std::map<float,ActionStats>& values);
+        // Seat 0's results go here instead of the seat's own table; size it
+        // from the strategy's getTrueCountRange() so no count lands out of range
+        EngineBuilder& setEVperTC(TrueCountHistogram& values);
 
         Engine build(Player* player);
+        // One seat per player, seat 0 first (see Engine's table constructor).
+        Engine build(const std::vector<Player*>& players);
 };
 #endif
\ No newline at end of file
@@ -19,6 +19,8 @@
 #include "GameConfig.h"
 #include "ActionStats.h"
 #include "MonteCarloScenario.h"
+#include "ScenarioTensor.h"
+#include "ScenarioMatcher.h"
 
 class FixedEngine{
 
@@ -27,17 +29,24 @@ public:
     // Legacy constructor for backward compatibility
     FixedEngine(std::vector<Action> monteCarloActions, std::map<std::pair<int, int>, std::map<float, DecisionPoint>> EVresults, const GameConfig& gameConfig = GameConfig());
     
-    // Legacy single-action calculateEV (for backward compatibility with tests)
-    void calculateEV(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount, std::pair<int,int> cardValues);
+    // Legacy single-action calculateEV (for backward compatibility with tests).
+    // Returns false when the shoe ran out mid-rollout; that rollout is not recorded.
+    bool calculateEV(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount, std::pair<int,int> cardValues);
     
-    // New multi-scenario calculateEV - evaluates all matching scenarios
-    void calculateEVForScenario(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount, 
-                                 std::pair<int,int> cardValues, const MonteCarloScenario& scenario);
+    // Multi-scenario calculateEV; scenarioId indexes gameConfig.monteCarloScenarios
+    bool calculateEVForScenario(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount, 
+                                 std::pair<int,int> cardValues, int scenarioId);
+    // Every scenario in the mask at once: each distinct forced action is rolled
+    // out once from the same shoe position and credited to each scenario comparing it
+    bool calculateEVForScenarios(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount,
+                                 std::pair<int,int> cardValues, ScenarioMatcher::Mask scenarios);
     
     void savetoCSVResults(const std::string& filename = "fixed_engine_results.csv") const;
     void saveScenarioResults(const std::string& scenarioName, const std::string& baseFilename) const;
+    // Every scenario's accumulators in ScenarioTensor's binary layout
+    void saveScenarioBinary(const std::string& filename) const;
     const std::map<std::pair<int, int>, std::map<float, DecisionPoint>>& getResults() const;
-    const std::map<std::pair<int, int>, std::map<float, DecisionPoint>>& getScenarioResults(const std::string& scenarioName) const;
+    const ScenarioTensor& getScenarioResults() const;
     std::vector<std::string> getScenarioNames() const;
     
     void merge(const FixedEngine& other);
@@ -47,19 +56,16 @@ private:
     std::vector<Action> monteCarloActions;
     std::map<std::pair<int, int>, std::map<float, DecisionPoint>> EVresults;
     
-    // Multi-scenario support: results keyed by scenario name
-    std::map<std::string, std::map<std::pair<int, int>, std::map<float, DecisionPoint>>> scenarioResults;
+    // Multi-scenario support: one preallocated tensor row per tracked hand
+    ScenarioTensor scenarioResults;
     
     GameConfig config;
+    bool shoeExhausted = false;
     
-    void evaluateHand(Deck& deck, Hand& dealer, std::vector<Hand>& hands, float trueCount, Action forcedAction,std::pair<int,int> cardValues, int baseBet);
-    
-    // New evaluateHand for scenario-specific results
-    void evaluateHandForScenario(Deck& deck, Hand& dealer, std::vector<Hand>& hands, float trueCount, 
-                                  Action forcedAction, std::pair<int,int> cardValues, int baseBet,
-                                  const std::string& scenarioName);
+    void evaluateHand(Deck& deck, Hand& dealer, std::vector<Hand>& hands, Action forcedAction, int baseBet, DecisionPoint& decisionPoint);
     
     void dealer_draw(Deck& deck, Hand& dealer);
+    std::optional<Card> drawCard(Deck& deck);
 
     bool standHandler(Hand& user, std::vector<Hand>& hands);
     bool hitHandler(Deck& deck, Hand& user, std::vector<Hand>& hands);
@@ -1,52 +1,88 @@
 #ifndef HAND_H
 #define HAND_H
 
-#include <vector>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include "Card.h"
 #include "BasicStrategy.h"
+
+// Read-only view over a hand's cards; valid while the hand is unchanged.
+class CardView{
+    private:
+        const Card* first_;
+        std::size_t size_;
+    public:
+        constexpr CardView(const Card* first, std::size_t size) : first_(first), size_(size) {}
+
+        const Card* begin() const { return first_; }
+        const Card* end() const { return first_ + size_; }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        const Card& operator[](std::size_t i) const { return first_[i]; }
+        const Card& front() const { return first_[0]; }
+        const Card& back() const { return first_[size_ - 1]; }
+};
+
+// Cards live inline and the hard total and ace count are kept up to date on
+// every add/pop, so copying or splitting a hand never allocates and every
+// score query is O(1).
 class Hand{
+    public:
+        // 21 cards is the most a hand can hold without going over 21 (one
+        // card per ace); one more slot covers a card that busts it.
+        static constexpr int MAX_CARDS = 22;
+
     private:
-        std::vector<Card> hand;
+        std::array<Card, MAX_CARDS> cards{};
+        std::uint8_t numCards = 0;
+        std::uint8_t aceCount = 0;
+        std::int16_t hardTotal = 0; // aces counted as 1
         int bet_size_;
-        static const int INDEX_OFFSET = 2; // Since dealer upcards start from 2
-        mutable int cachedScore = -1;
-        mutable bool cachedIsSoft = false;
-        mutable bool scoreValid = false;
 
-        void invalidateCache() { scoreValid = false; cachedIsSoft = false; cachedScore = -1;}
+        void push(Card card) {
+            assert(numCards < MAX_CARDS);
+            cards[numCards++] = card;
+            hardTotal += card.isAce() ? 1 : card.getValue();
+            aceCount += card.isAce() ? 1 : 0;
+        }
     
     public:
         Hand(std::pair<Card,Card> cards, int bet_size);
         Hand(Card card, int bet_size);
         
-        int getBetSize();
-        void doubleBet();
+        int getBetSize() const { return bet_size_; }
+        void doubleBet() { bet_size_ *= 2; }
 
-        Card getLastCard();
+        Card getLastCard() const { return cards[numCards - 1]; }
         void popLastCard();
-        void addCard(Card card);
+        void addCard(Card card) { push(card); }
 
-        bool checkCanSplit();
-        bool checkCanDouble();
-        bool checkShouldStand();
+        bool checkCanSplit() const { return numCards == 2 && cards[0].getRank() == cards[1].getRank(); }
+        bool checkCanDouble() const { return numCards == 2; }
+        bool checkShouldStand() const;
 
-        bool checkOver();
-        bool isDealerOver();
+        bool checkOver() const { return getScore() > 21; }
+        bool isDealerOver() const { return getScore() >= 17; }
 
-        int getScore();
-        int getFinalScore();
+        int getScore() const { return isHandSoft() ? hardTotal + 10 : hardTotal; }
+        int getHardTotal() const { return hardTotal; }
+        bool hasAce() const { return aceCount > 0; }
+        int getFinalScore() const;
 
-        bool OfferInsurance();
-        bool dealerHiddenTen();
-        bool dealerShowsTen();
-        bool dealerHiddenAce();
-        Rank peekFrontCard();
+        bool OfferInsurance() const { return cards[0].isAce(); }
+        bool dealerHiddenTen() const { return getLastCard().isWorthTen(); }
+        bool dealerShowsTen() const { return cards[0].isWorthTen(); }
+        bool dealerHiddenAce() const { return getLastCard().isAce(); }
+        Rank peekFrontCard() const { return cards[0].getRank(); }
 
-        bool isBlackjack();
-        bool isHandSoft();
-        bool isSoft17();
-        bool isAces();
-        const std::vector<Card>& getCards() const;
+        bool isBlackjack() const { return numCards == 2 && aceCount == 1 && hardTotal == 11; }
+        // One ace can still count as 11 without going over 21.
+        bool isHandSoft() const { return aceCount > 0 && hardTotal + 10 <= 21; }
+        bool isSoft17() const { return hardTotal == 7 && aceCount > 0; }
+        bool isAces() const { return numCards == 2 && aceCount == 2; }
+        CardView getCards() const { return CardView(cards.data(), numCards); }
 };
 
 #endif
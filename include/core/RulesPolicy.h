@@ -0,0 +1,25 @@
+#ifndef RULESPOLICY_H
+#define RULESPOLICY_H
+
+#include "GameConfig.h"
+
+// Rule flags the engine's play loop branches on. StaticRules fixes them at
+// compile time, so plain RTP runs compile the unused branches (and all Monte
+// Carlo hooks) away. RuntimeRules reads them from GameConfig for every other
+// combination.
+template <bool HitSoft17, bool DoubleAfterSplit, bool ReSplitAces>
+struct StaticRules {
+    static constexpr bool hitSoft17(const GameConfig&) { return HitSoft17; }
+    static constexpr bool doubleAfterSplit(const GameConfig&) { return DoubleAfterSplit; }
+    static constexpr bool reSplitAces(const GameConfig&) { return ReSplitAces; }
+    static constexpr bool monteCarlo(const GameConfig&) { return false; }
+};
+
+struct RuntimeRules {
+    static bool hitSoft17(const GameConfig& config) { return config.dealerHitsSoft17; }
+    static bool doubleAfterSplit(const GameConfig& config) { return config.doubleAfterSplitAllowed; }
+    static bool reSplitAces(const GameConfig& config) { return config.allowReSplitAces; }
+    static bool monteCarlo(const GameConfig& config) { return config.enabelMontiCarlo; }
+};
+
+#endif
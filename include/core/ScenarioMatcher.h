@@ -0,0 +1,45 @@
+#ifndef SCENARIOMATCHER_H
+#define SCENARIOMATCHER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "MonteCarloScenario.h"
+
+// MonteCarloScenario::appliesTo for every scenario at once, compiled into a
+// table of scenario-id bitmasks indexed by (insurance phase, soft, pair,
+// player total, upcard). A hand no scenario tracks costs one load.
+class ScenarioMatcher {
+    public:
+        using Mask = std::uint64_t;
+        static constexpr int MAX_SCENARIOS = 64;
+        static constexpr int TOTALS = 22;   // player total 0-21
+        static constexpr int UPCARDS = 12;  // dealer upcard value 0-11, ace = 11
+
+        ScenarioMatcher() = default;
+        // Scenario ids are positions in `scenarios`; throws std::invalid_argument
+        // past MAX_SCENARIOS or for a hand outside the table
+        explicit ScenarioMatcher(const std::vector<MonteCarloScenario>& scenarios);
+
+        // Bit i is set when scenarios[i] applies to this hand in this phase
+        Mask match(int playerTotal, int dealerUpcard, bool isSoftHand, bool canSplit, bool insurancePhase) const {
+            if (static_cast<unsigned>(playerTotal) >= TOTALS || static_cast<unsigned>(dealerUpcard) >= UPCARDS) {
+                return 0;
+            }
+            return table[index(playerTotal, dealerUpcard, isSoftHand, canSplit, insurancePhase)];
+        }
+        bool hasInsuranceScenarios() const { return insurance; }
+
+        // Lowest scenario id in a non-empty mask
+        static int firstId(Mask mask) { return __builtin_ctzll(mask); }
+
+    private:
+        static constexpr int index(int playerTotal, int dealerUpcard, bool isSoftHand, bool canSplit, bool insurancePhase) {
+            return (((insurancePhase * 2 + isSoftHand) * 2 + canSplit) * TOTALS + playerTotal) * UPCARDS + dealerUpcard;
+        }
+
+        std::array<Mask, 2 * 2 * 2 * TOTALS * UPCARDS> table{};
+        bool insurance = false;
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef SCENARIOTENSOR_H
+#define SCENARIOTENSOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ActionStats.h"
+#include "MonteCarloScenario.h"
+
+// Monte Carlo results for a fixed set of scenarios, preallocated as one flat
+// array indexed [scenario][player total][upcard][true count bucket][action].
+// Only the (total, upcard) cells a scenario tracks get rows; each row is a run
+// of DecisionPoints, one per half-TC bucket plus an underflow and an overflow.
+class ScenarioTensor {
+    public:
+        static constexpr int TOTALS = 22;   // player total 0-21
+        static constexpr int UPCARDS = 12;  // dealer upcard value 0-11, ace = 11
+        static constexpr int BUCKETS_PER_TC = 2;
+        static constexpr float DEFAULT_MIN = -60.0f;
+        static constexpr float DEFAULT_MAX = 60.0f;
+
+        ScenarioTensor(float minTrueCount = DEFAULT_MIN, float maxTrueCount = DEFAULT_MAX);
+        ScenarioTensor(const std::vector<MonteCarloScenario>& scenarios,
+                       float minTrueCount = DEFAULT_MIN, float maxTrueCount = DEFAULT_MAX);
+
+        int scenarioCount() const { return static_cast<int>(names.size()); }
+        const std::string& scenarioName(int scenario) const { return names[scenario]; }
+        // -1 when no scenario has this name
+        int findScenario(const std::string& name) const;
+
+        // 0 is underflow, bucketCount() - 1 overflow
+        int bucketIndex(float trueCount) const {
+            const int half = static_cast<int>(std::round(trueCount * BUCKETS_PER_TC)) - firstHalf + 1;
+            return std::clamp(half, 0, buckets - 1);
+        }
+        int bucketCount() const { return buckets; }
+        bool isUnderflow(int bucket) const { return bucket == 0; }
+        bool isOverflow(int bucket) const { return bucket == buckets - 1; }
+        // Rounded true count of an in-range bucket
+        float bucketTrueCount(int bucket) const { return static_cast<float>(firstHalf + bucket - 1) / BUCKETS_PER_TC; }
+        float getMinTrueCount() const { return bucketTrueCount(1); }
+        float getMaxTrueCount() const { return bucketTrueCount(buckets - 2); }
+
+        // First bucket of the scenario's row for this total vs upcard, or
+        // nullptr when the scenario does not track it
+        DecisionPoint* row(int scenario, std::pair<int, int> cardValues) {
+            const int r = rowIndex(scenario, cardValues);
+            return r < 0 ? nullptr : &points[static_cast<std::size_t>(r) * buckets];
+        }
+        const DecisionPoint* row(int scenario, std::pair<int, int> cardValues) const {
+            const int r = rowIndex(scenario, cardValues);
+            return r < 0 ? nullptr : &points[static_cast<std::size_t>(r) * buckets];
+        }
+        DecisionPoint* at(int scenario, std::pair<int, int> cardValues, float trueCount) {
+            DecisionPoint* first = row(scenario, cardValues);
+            return first ? first + bucketIndex(trueCount) : nullptr;
+        }
+
+        // Tracked (total, upcard) pairs of a scenario, in ascending order
+        std::vector<std::pair<int, int>> trackedCells(int scenario) const;
+
+        // Element-wise; both tensors must share the same layout
+        void merge(const ScenarioTensor& other);
+        bool sameLayout(const ScenarioTensor& other) const;
+        void clear();
+
+        // FixedEngine::savetoCSVResults' columns and row order, plus the paired
+        // difference of the scenario's first two actions before "Hands Played";
+        // empty buckets are skipped, and out-of-range ones are counted on stderr
+        void writeCSV(int scenario, std::ostream& out) const;
+        // Layout followed by the raw accumulators; readBinary throws
+        // std::runtime_error on a malformed stream
+        void writeBinary(std::ostream& out) const;
+        static ScenarioTensor readBinary(std::istream& in);
+
+    private:
+        int rowIndex(int scenario, std::pair<int, int> cardValues) const {
+            if (cardValues.first < 0 || cardValues.first >= TOTALS || cardValues.second < 0 || cardValues.second >= UPCARDS) {
+                return -1;
+            }
+            return rows[(static_cast<std::size_t>(scenario) * TOTALS + cardValues.first) * UPCARDS + cardValues.second];
+        }
+        void addScenario(const std::string& name, const std::vector<std::pair<int, int>>& cells);
+
+        int firstHalf;
+        int buckets;
+        std::vector<std::string> names;
+        // [scenario][total][upcard] -> row, -1 when untracked
+        std::vector<std::int32_t> rows;
+        // [row][bucket]
+        std::vector<DecisionPoint> points;
+};
+
+#endif
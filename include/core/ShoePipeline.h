@@ -0,0 +1,54 @@
+#ifndef SHOEPIPELINE_H
+#define SHOEPIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Deck.h"
+#include "SpscRing.h"
+
+// Shuffles shoes on a background thread while the caller plays them.
+// Shoe i is Deck::resetForShoe(streamKey, firstShoe + i) with a full
+// shuffle, delivered in order, so results match a sequential loop over the
+// same stream. A fixed pool of decks cycles between a free ring and a ready
+// ring; nothing is allocated once the pool is built.
+class ShoePipeline {
+    public:
+        ShoePipeline(int numDecks, std::uint64_t streamKey, std::uint64_t shoeCount,
+                     std::uint64_t firstShoe = 0, std::size_t poolSize = 32);
+        ~ShoePipeline();
+
+        ShoePipeline(const ShoePipeline&) = delete;
+        ShoePipeline& operator=(const ShoePipeline&) = delete;
+
+        // Next shuffled shoe. Hands the previously returned shoe back to the
+        // producer, so that reference is invalid after this call. Call at most
+        // shoeCount times.
+        const Deck& next();
+
+    private:
+        std::vector<Deck> pool;
+        SpscRing<std::size_t> freeSlots;
+        SpscRing<std::size_t> readySlots;
+        std::uint64_t streamKey;
+        std::uint64_t firstShoe;
+        std::uint64_t shoeCount;
+        std::size_t current;
+        bool holding = false;
+        std::atomic<bool> stopping{false};
+        // The producer sleeps here while every shoe is shuffled and waiting;
+        // next() wakes it when it returns a shoe to the free ring
+        std::mutex freeMutex;
+        std::condition_variable freeReady;
+        std::thread producer;
+
+        void wakeProducer();
+
+        void produce();
+};
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef SHOERNG_H
+#define SHOERNG_H
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+
+// Counter-based Philox2x64-10 generator. The state is a 64-bit key plus a
+// (stream, block) counter, so every shoe of a run is addressable directly:
+// shoe n of a strategy is stream n under key deriveKey(seed, strategy).
+class ShoeRng {
+    public:
+        using result_type = std::uint64_t;
+
+        ShoeRng(std::uint64_t key = 0, std::uint64_t stream = 0);
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            if (buffered == 0) {
+                generateBlock();
+            }
+            return buffer[--buffered];
+        }
+
+        // Jump to output `position` of `stream` in O(1).
+        void seek(std::uint64_t stream, std::uint64_t position = 0);
+        std::uint64_t getKey() const;
+        std::uint64_t getStream() const;
+
+        // Uniform integer in [0, range) (Lemire's nearly divisionless method).
+        std::uint32_t bounded(std::uint32_t range) {
+            unsigned __int128 product = static_cast<unsigned __int128>((*this)()) * range;
+            std::uint64_t leftover = static_cast<std::uint64_t>(product);
+            if (leftover < range) {
+                const std::uint64_t threshold = (0 - static_cast<std::uint64_t>(range)) % range;
+                while (leftover < threshold) {
+                    product = static_cast<unsigned __int128>((*this)()) * range;
+                    leftover = static_cast<std::uint64_t>(product);
+                }
+            }
+            return static_cast<std::uint32_t>(product >> 64);
+        }
+
+        // Two independent uniform integers in [0, range1) and [0, range2) from a
+        // single 64-bit draw (Brackett-Rozinsky & Lemire batched ranged integers).
+        void bounded2(std::uint32_t range1, std::uint32_t range2, std::uint32_t& out1, std::uint32_t& out2) {
+            const std::uint64_t bound = static_cast<std::uint64_t>(range1) * range2;
+            std::uint64_t leftover = draw2(range1, range2, out1, out2);
+            if (leftover < bound) {
+                const std::uint64_t threshold = (0 - bound) % bound;
+                while (leftover < threshold) {
+                    leftover = draw2(range1, range2, out1, out2);
+                }
+            }
+        }
+
+        // Fisher-Yates from the back, two swap positions per 64-bit draw.
+        template <class RandomIt>
+        void shuffle(RandomIt first, RandomIt last) {
+            std::uint32_t remaining = static_cast<std::uint32_t>(last - first);
+            while (remaining >= 3) {
+                std::uint32_t a;
+                std::uint32_t b;
+                bounded2(remaining, remaining - 1, a, b);
+                std::swap(first[remaining - 1], first[a]);
+                std::swap(first[remaining - 2], first[b]);
+                remaining -= 2;
+            }
+            if (remaining == 2) {
+                std::swap(first[1], first[bounded(2)]);
+            }
+        }
+
+        // Mix a run seed with a per-strategy tag into an independent stream key.
+        static std::uint64_t deriveKey(std::uint64_t seed, std::uint64_t tag);
+        static std::uint64_t hashTag(const std::string& name);
+
+    private:
+        std::uint64_t key = 0;
+        std::uint64_t stream = 0;
+        std::uint64_t block = 0;
+        std::uint64_t buffer[2] = {0, 0};
+        int buffered = 0;
+
+        void generateBlock();
+
+        std::uint64_t draw2(std::uint32_t range1, std::uint32_t range2, std::uint32_t& out1, std::uint32_t& out2) {
+            unsigned __int128 product = static_cast<unsigned __int128>((*this)()) * range1;
+            out1 = static_cast<std::uint32_t>(product >> 64);
+            product = static_cast<unsigned __int128>(static_cast<std::uint64_t>(product)) * range2;
+            out2 = static_cast<std::uint32_t>(product >> 64);
+            return static_cast<std::uint64_t>(product);
+        }
+};
+
+#endif
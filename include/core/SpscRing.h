@@ -0,0 +1,50 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity is rounded up to a power of two.
+template <class T>
+class SpscRing {
+    public:
+        explicit SpscRing(std::size_t minCapacity) {
+            std::size_t capacity = 1;
+            while (capacity < minCapacity) {
+                capacity <<= 1;
+            }
+            slots.resize(capacity);
+            mask = capacity - 1;
+        }
+
+        bool tryPush(const T& value) {
+            const std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+            if (tail - headIndex.load(std::memory_order_acquire) > mask) {
+                return false;
+            }
+            slots[tail & mask] = value;
+            tailIndex.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool tryPop(T& value) {
+            const std::size_t head = headIndex.load(std::memory_order_relaxed);
+            if (head == tailIndex.load(std::memory_order_acquire)) {
+                return false;
+            }
+            value = slots[head & mask];
+            headIndex.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::vector<T> slots;
+        std::size_t mask = 0;
+        // Separate cache lines so producer and consumer do not contend
+        alignas(64) std::atomic<std::size_t> headIndex{0};
+        alignas(64) std::atomic<std::size_t> tailIndex{0};
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef TRACEPOLICY_H
+#define TRACEPOLICY_H
+
+// Whether the engine's play loop talks to GameReporter at all. Reporting sites
+// are guarded with `if constexpr (Trace::enabled)`, so a NullTrace loop builds
+// no labels, summaries or reporter calls. EventTrace is chosen when the engine
+// was built with events enabled (interactive play, tests with observers).
+struct NullTrace {
+    static constexpr bool enabled = false;
+};
+
+struct EventTrace {
+    static constexpr bool enabled = true;
+};
+
+#endif
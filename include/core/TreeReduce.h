@@ -0,0 +1,29 @@
+#ifndef TREEREDUCE_H
+#define TREEREDUCE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Folds per-worker accumulators into parts[0] in log2(n) rounds: round r
+// merges parts[i + 2^r] into parts[i], each merge of a round on its own
+// thread. T needs merge(const T&); the other entries are left merged-from.
+template <class T>
+T& treeReduce(std::vector<T>& parts) {
+    if (parts.empty()) {
+        throw std::invalid_argument("treeReduce needs at least one part");
+    }
+    for (std::size_t stride = 1; stride < parts.size(); stride *= 2) {
+        std::vector<std::thread> merges;
+        for (std::size_t i = 0; i + stride < parts.size(); i += 2 * stride) {
+            merges.emplace_back([&parts, i, stride]() { parts[i].merge(parts[i + stride]); });
+        }
+        for (std::thread& t : merges) {
+            t.join();
+        }
+    }
+    return parts.front();
+}
+
+#endif
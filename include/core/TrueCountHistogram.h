@@ -0,0 +1,54 @@
+#ifndef TRUECOUNTHISTOGRAM_H
+#define TRUECOUNTHISTOGRAM_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "ActionStats.h"
+
+// Hand results per true count rounded to the nearest half, in a flat array
+// over [minTrueCount, maxTrueCount] plus an underflow and an overflow bin.
+// A result is one index computation and one add; merging is a bin-wise sum.
+class TrueCountHistogram {
+    public:
+        static constexpr float DEFAULT_MIN = -30.0f;
+        static constexpr float DEFAULT_MAX = 30.0f;
+        static constexpr int BINS_PER_TC = 2;
+
+        TrueCountHistogram(float minTrueCount = DEFAULT_MIN, float maxTrueCount = DEFAULT_MAX);
+
+        // 0 is underflow, binCount() - 1 overflow
+        int binIndex(float trueCount) const {
+            const int half = static_cast<int>(std::round(trueCount * BINS_PER_TC)) - firstHalf + 1;
+            return std::clamp(half, 0, binCount() - 1);
+        }
+        ActionStats& bin(int index) { return bins[index].stats; }
+        const ActionStats& bin(int index) const { return bins[index].stats; }
+        ActionStats& at(float trueCount) { return bin(binIndex(trueCount)); }
+        void addResult(float trueCount, double net, double wagered) { at(trueCount).addResult(net, wagered); }
+
+        int binCount() const { return static_cast<int>(bins.size()); }
+        bool isUnderflow(int index) const { return index == 0; }
+        bool isOverflow(int index) const { return index == binCount() - 1; }
+        // Rounded true count of an in-range bin
+        float binTrueCount(int index) const { return static_cast<float>(firstHalf + index - 1) / BINS_PER_TC; }
+        float getMinTrueCount() const { return binTrueCount(1); }
+        float getMaxTrueCount() const { return binTrueCount(binCount() - 2); }
+
+        // Bins that have seen a result
+        int occupiedBins() const;
+        // Bin-wise; both histograms must share the same range
+        void merge(const TrueCountHistogram& other);
+        void clear();
+
+    private:
+        // One accumulator per cache line so neighbouring bins never share one
+        struct alignas(64) Bin {
+            ActionStats stats;
+        };
+
+        int firstHalf;
+        std::vector<Bin> bins;
+};
+
+#endif
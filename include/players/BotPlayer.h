@@ -2,26 +2,66 @@
 #define BOTPLAYER_H
 
 #include <memory>
+#include <variant>
 
 #include "Player.h"
 #include "BasicStrategy.h"
 #include "CountingStrategy.h"
+#include "HiLoStrategy.h"
+#include "MentorStrategy.h"
+#include "NoStrategy.h"
+#include "OmegaIIStrategy.h"
+#include "R14Strategy.h"
+#include "RAPCStrategy.h"
+#include "RPCStrategy.h"
+#include "WongHalvesStrategy.h"
+#include "ZenCountStrategy.h"
+#include "KISSIIIStrategy.h"
+#include "KoStrategy.h"
+#include "Red7Strategy.h"
+#include "UZenIIStrategy.h"
+#include "UstonSSStrategy.h"
+#include "MultiCountTracker.h"
 
-class BotPlayer : public Player {
+// The owned strategy seen through its concrete (final) type, so counting and
+// decisions compile to direct calls. Anything else, e.g. LoggingCountingStrategy,
+// stays on the virtual CountingStrategy* path.
+using StrategyRef = std::variant<
+    CountingStrategy*,
+    HiLoStrategy*, MentorStrategy*, NoStrategy*, OmegaIIStrategy*, R14Strategy*,
+    RAPCStrategy*, RPCStrategy*, WongHalvesStrategy*, ZenCountStrategy*,
+    KISSIIIStrategy*, KoStrategy*, Red7Strategy*, UZenIIStrategy*, UstonSSStrategy*,
+    MultiCountTracker*>;
+
+class BotPlayer final : public Player {
 private:
     bool allowSurrender;
     std::unique_ptr<CountingStrategy> strategy;
+    StrategyRef typedStrategy;
+    // The strategy's compiled decisions; nullptr for strategies outside StrategyRef
+    const DecisionTable* decisions;
+
+    Action decide(const DecisionTable& table, Hand& user, Hand& dealer, float trueCount);
+    Action decide(CountingStrategy& strat, Hand& user, Hand& dealer, float trueCount);
 public:
     BotPlayer(bool allowSurrender = false, std::unique_ptr<CountingStrategy> strat = nullptr);
     ~BotPlayer() override = default;
     Action getAction(Hand& user, Hand& dealer, float trueCount) override;
     CountingStrategy* getStrategy() override;
     
-    void updateDeckStrategySize(int num_cards_left) override;
-    int getBetSize() override ;
+    void updateDeckStrategySize(int num_cards_left) override {
+        std::visit([num_cards_left](auto* strat) { strat->updateDeckSize(num_cards_left); }, typedStrategy);
+    }
+    int getBetSize() override {
+        return std::visit([](auto* strat) { return strat->getBetSize(); }, typedStrategy);
+    }
     void setUnitSize(float kellyFraction) override ;
-    void updateCount(Card card) override;
-    float getTrueCount() override;
+    void updateCount(Card card) override {
+        std::visit([card](auto* strat) { strat->updateCount(card); }, typedStrategy);
+    }
+    float getTrueCount() override {
+        return std::visit([](auto* strat) { return strat->getTrueCount(); }, typedStrategy);
+    }
     bool shouldAcceptInsurance() override;
     void resetCount(int deckSize);
     std::string getStrategyName();
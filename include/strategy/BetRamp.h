@@ -0,0 +1,50 @@
+#ifndef BETRAMP_H
+#define BETRAMP_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// Kelly bet for every half true count, precomputed from a strategy's EV line
+// and one bankroll. Each strategy owns its ramp, so sizing a bet is a table
+// load with nothing shared between threads.
+class BetRamp {
+    public:
+        static constexpr int BUCKETS_PER_TC = 2;
+        static constexpr int BUCKETS = 64;              // true counts 0 to 31.5; higher counts use the last
+        static constexpr double DEFAULT_BALANCE = 1000.0; // until an engine supplies its wallet
+
+        BetRamp(float evPerTC, float evIntercept, float avgVolatility, float profitableTC, int minBet, int maxBet);
+
+        // The intercept follows the bankroll at once; the unit on the next setKellyFraction
+        void setInitialBalance(double balance);
+        // Kelly-size the unit from the current bankroll (it is 25 until then)
+        void setKellyFraction(float fraction);
+
+        // The count is rounded to the nearest half, as the engine buckets EV per TC
+        int betFor(float trueCount) const {
+            const int bucket = static_cast<int>(std::round(trueCount * BUCKETS_PER_TC));
+            return bets[std::clamp(bucket, 0, BUCKETS - 1)];
+        }
+
+        double getInitialBalance() const { return initialBalance; }
+        float getKellyFraction() const { return kellyFraction; }
+        float getUnitSize() const { return unitSize; }
+
+    private:
+        void build();
+
+        float evPerTC;
+        float evIntercept;
+        float avgVolatility;
+        float profitableTC;
+        int minBet;
+        int maxBet;
+
+        double initialBalance = DEFAULT_BALANCE;
+        float kellyFraction = 0.5f;
+        float unitSize = 25.0f;
+        std::array<int, BUCKETS> bets{};
+};
+
+#endif
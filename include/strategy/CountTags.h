@@ -0,0 +1,66 @@
+#ifndef COUNTTAGS_H
+#define COUNTTAGS_H
+
+#include <array>
+#include <utility>
+#include "Card.h"
+
+// Count tag of every card for each counting system, indexed by Card::getCode().
+// Built at compile time, so updateCount is one table load per card.
+namespace CountTags {
+    using Table = std::array<float, Card::CODE_COUNT>;
+    // Tags for Two through Ace, in Rank order
+    using RankTags = std::array<float, 13>;
+
+    constexpr Table fromRanks(const RankTags& tags) {
+        Table table{};
+        for (int suit = 0; suit < 4; ++suit) {
+            for (int rank = 0; rank < 13; ++rank) {
+                table[Card(static_cast<Rank>(rank), static_cast<Suit>(suit)).getCode()] = tags[rank];
+            }
+        }
+        return table;
+    }
+
+    // Suit-dependent systems override single cards of an otherwise per-rank table.
+    constexpr Table withCard(Table table, Rank rank, Suit suit, float tag) {
+        table[Card(rank, suit).getCode()] = tag;
+        return table;
+    }
+
+    //                                           2     3     4     5     6     7     8     9    10     J     Q     K     A
+    inline constexpr Table HI_LO       = fromRanks({ 1,    1,    1,    1,    1,    0,    0,    0,   -1,   -1,   -1,   -1,   -1});
+    inline constexpr Table ZEN         = fromRanks({ 1,    1,    2,    2,    2,    1,    0,    0,   -2,   -2,   -2,   -2,   -1});
+    inline constexpr Table MENTOR      = fromRanks({ 1,    2,    2,    2,    2,    1,    0,   -1,   -2,   -2,   -2,   -2,   -1});
+    inline constexpr Table OMEGA_II    = fromRanks({ 1,    1,    2,    2,    2,    1,    0,   -1,   -2,   -2,   -2,   -2,    0});
+    inline constexpr Table R14         = fromRanks({ 2,    2,    3,    4,    2,    1,    0,   -2,   -3,   -3,   -3,   -3,    0});
+    inline constexpr Table RAPC        = fromRanks({ 2,    3,    3,    4,    3,    2,    0,   -1,   -3,   -3,   -3,   -3,   -4});
+    inline constexpr Table RPC         = fromRanks({ 1,    2,    2,    2,    2,    1,    0,    0,   -2,   -2,   -2,   -2,   -2});
+    inline constexpr Table WONG_HALVES = fromRanks({.5f,   1,    1, 1.5f,    1,  .5f,    0, -.5f,   -1,   -1,   -1,   -1,   -1});
+    inline constexpr Table KO          = fromRanks({ 1,    1,    1,    1,    1,    1,    0,    0,   -1,   -1,   -1,   -1,   -1});
+    inline constexpr Table UZEN_II     = fromRanks({ 1,    2,    2,    2,    2,    1,    0,    0,   -2,   -2,   -2,   -2,   -1});
+    inline constexpr Table USTON_SS    = fromRanks({ 2,    2,    2,    3,    2,    1,    0,   -1,   -2,   -2,   -2,   -2,   -2});
+
+    // Red 7: sevens count only when red
+    inline constexpr Table RED_7 = withCard(withCard(
+        fromRanks({ 1,    1,    1,    1,    1,    1,    0,    0,   -1,   -1,   -1,   -1,   -1}),
+        Rank::Seven, Suit::Spades, 0), Rank::Seven, Suit::Clubs, 0);
+    // KISS III: twos count only when black
+    inline constexpr Table KISS_III = withCard(withCard(
+        fromRanks({ 1,    1,    1,    1,    1,    1,    0,    0,   -1,   -1,   -1,   -1,   -1}),
+        Rank::Two, Suit::Hearts, 0), Rank::Two, Suit::Diamonds, 0);
+
+    // {lowest, highest} running count an unbalanced system can reach in a shoe
+    // of `decks` decks: the IRC plus every negative (or every positive) tag
+    constexpr std::pair<float, float> runningCountRange(const Table& tags, float ircPerDeck, int decks) {
+        float negative = 0.0f;
+        float positive = 0.0f;
+        for (float tag : tags) {
+            (tag < 0 ? negative : positive) += tag;
+        }
+        const float initial = ircPerDeck * decks;
+        return {initial + negative * decks, initial + positive * decks};
+    }
+}
+
+#endif
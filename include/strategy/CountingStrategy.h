@@ -1,8 +1,13 @@
 #ifndef COUNTINGSTRATEGY_H
 #define COUNTINGSTRATEGY_H
 
+#include <cmath>
+#include <utility>
 #include "action.h"
 #include "Card.h"
+#include "DecisionTable.h"
+#include "DeviationLoader.h"
+#include "TrueCountHistogram.h"
 
 class CountingStrategy {
     public:
@@ -11,10 +16,19 @@ class CountingStrategy {
         virtual void updateDeckSize(int num_cards_left) = 0;
         // Set the Kelly fraction (must be handled by each strategy implementation)
         virtual void setUnitSize(float kellyFraction) = 0;
+        // Bankroll the Kelly bet ramp is sized from; the engine passes its wallet
+        virtual void setInitialBalance(double balance) { (void)balance; }
 
         virtual float getTrueCount() const = 0;
         virtual float getDecksLeft() const = 0;
         virtual float getRunningCount() const = 0;
+        // {lowest, highest} getTrueCount() the engine's EV-per-TC table covers
+        // for a shoe of `decks` decks; unbalanced systems report their running
+        // count and widen it to everything reachable from the IRC
+        virtual std::pair<float, float> getTrueCountRange(int decks) const {
+            (void)decks;
+            return {TrueCountHistogram::DEFAULT_MIN, TrueCountHistogram::DEFAULT_MAX};
+        }
         
         virtual bool shouldAcceptInsurance() const = 0;
 
@@ -30,6 +44,21 @@ class CountingStrategy {
         virtual Action getSplitAction(Rank playerSplitRank, Rank dealerUpcard,float true_count)= 0 ;
 
         virtual void reset(int deckSize) = 0;
+        // Every decision above, precompiled by the strategy; see DecisionTable.h
+        const DecisionTable& getDecisionTable() const { return decisions; }
+        // Play from simulated indices instead of the hardcoded ones; nullptr restores them
+        void useDeviations(const DeviationSet* loaded) {
+            decisions.setDeviations(loaded);
+            decisions.build(*this);
+        }
+        // Insurance by the loaded index when there is one
+        bool acceptsInsurance() const {
+            const DeviationSet* loaded = decisions.getDeviations();
+            if (loaded && !std::isnan(loaded->insuranceIndex)) {
+                return getTrueCount() >= loaded->insuranceIndex;
+            }
+            return shouldAcceptInsurance();
+        }
         virtual std::string getName() = 0;
 
         // Minimum and maximum bet constants (centralized defaults)
@@ -43,6 +72,8 @@ class CountingStrategy {
     protected:
         // Default unit sizing stored in base for convenience
         float unitSize = 25.0f;
+        // Concrete strategies build this at construction and whenever their indices change
+        DecisionTable decisions;
 
 };
 
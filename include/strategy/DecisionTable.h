@@ -0,0 +1,49 @@
+#ifndef DECISIONTABLE_H
+#define DECISIONTABLE_H
+
+#include <array>
+#include <limits>
+#include "action.h"
+#include "rank.h"
+
+class CountingStrategy;
+class DeviationSet;
+
+// A strategy's playing decisions compiled into [hand class][total][upcard]
+// cells: the basic action, and the deviation taken once the true count
+// reaches the cell's index. Picking an action is one load and one compare.
+class DecisionTable {
+    public:
+        enum HandClass { Hard, Soft, Pair, Surrender, CLASS_COUNT };
+        static constexpr int TOTALS = 22;  // hand total; rank for Pair
+        static constexpr int UPCARDS = 13; // dealer upcard rank
+
+        struct Entry {
+            Action basic = Action::Hit;
+            Action deviation = Action::Hit;
+            float index = std::numeric_limits<float>::infinity();
+        };
+
+        // Probe every cell of strategy's get*Action/shouldSurrender and find the
+        // exact count at which each answer changes, so lookups reproduce them.
+        // Loaded deviations (see DeviationLoader.h) then override their cells.
+        void build(CountingStrategy& strategy);
+        void setDeviations(const DeviationSet* loaded) { deviations = loaded; }
+        const DeviationSet* getDeviations() const { return deviations; }
+        // Override one cell: `below` under the index, `atOrAbove` from it on
+        void setIndex(HandClass handClass, int total, Rank upcard, float index, Action below, Action atOrAbove);
+
+        Action lookup(HandClass handClass, int total, Rank upcard, float trueCount) const {
+            const Entry& cell = cells[handClass][total][static_cast<int>(upcard)];
+            return trueCount >= cell.index ? cell.deviation : cell.basic;
+        }
+        const Entry& entry(HandClass handClass, int total, Rank upcard) const {
+            return cells[handClass][total][static_cast<int>(upcard)];
+        }
+
+    private:
+        std::array<std::array<std::array<Entry, UPCARDS>, TOTALS>, CLASS_COUNT> cells{};
+        const DeviationSet* deviations = nullptr;
+};
+
+#endif
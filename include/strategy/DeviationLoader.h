@@ -0,0 +1,54 @@
+#ifndef DEVIATIONLOADER_H
+#define DEVIATIONLOADER_H
+
+#include <array>
+#include <limits>
+#include <map>
+#include <string>
+#include "DecisionTable.h"
+
+// Simulated crossover indices for one (strategy, rules, decks, penetration),
+// laid out like DecisionTable's cells so applying them is a straight copy.
+class DeviationSet {
+    public:
+        void setIndex(DecisionTable::HandClass handClass, int total, Rank upcard, float index, Action below, Action atOrAbove);
+        // Index of `handClass` total vs upcard, or NaN when the report has none
+        float getIndex(DecisionTable::HandClass handClass, int total, Rank upcard) const;
+        void applyTo(DecisionTable& table) const;
+
+        float insuranceIndex = NOT_FOUND;
+
+    private:
+        static constexpr float NOT_FOUND = std::numeric_limits<float>::quiet_NaN();
+
+        struct Crossover {
+            float index = NOT_FOUND;
+            Action below = Action::Hit;
+            Action atOrAbove = Action::Hit;
+        };
+        std::array<std::array<std::array<Crossover, DecisionTable::UPCARDS>, DecisionTable::TOTALS>, DecisionTable::CLASS_COUNT> cells{};
+};
+
+// Reads data/deviation_data/deviation_report_*.csv files once and hands out
+// the DeviationSet for a game; strategies keep a pointer, so the loader must
+// outlive them.
+class DeviationLoader {
+    public:
+        // Parse one report; throws std::runtime_error naming the file (and row)
+        // if it cannot be opened, a number does not parse, or a decision's
+        // Action A/Action B columns are not the pair it expects
+        void loadReport(const std::string& path);
+        // Every deviation_report_*.csv in directory; returns how many were read
+        int loadDirectory(const std::string& directory);
+
+        // nullptr when no report covers this game
+        const DeviationSet* find(const std::string& strategyName, bool dealerHitsSoft17, int numDecks, float penetration) const;
+
+        // The report's "Game Config" column, e.g. "2deck_65pen"
+        static std::string gameKey(int numDecks, float penetration);
+
+    private:
+        std::map<std::string, DeviationSet> sets;
+};
+
+#endif
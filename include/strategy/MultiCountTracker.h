@@ -0,0 +1,80 @@
+#ifndef MULTICOUNTTRACKER_H
+#define MULTICOUNTTRACKER_H
+
+#include <array>
+#include <string>
+#include <utility>
+
+#include "CountingStrategy.h"
+#include "Card.h"
+#include "action.h"
+#include "TrueCountHistogram.h"
+#include "NoStrategy.h"
+
+// Plays flat-bet basic strategy while keeping the running count of every
+// shipped counting system side by side, one float lane per system. Each hand's
+// results are credited to every lane's count bucket, so a single simulation
+// yields an EV-per-TC table for all systems on the same card stream.
+// Balanced lanes bucket by true count; unbalanced lanes by running count.
+class MultiCountTracker final : public CountingStrategy {
+    public:
+        static constexpr int LANES = 13;
+        static constexpr int BALANCED_LANES = 8;
+        // Padded to whole SIMD registers so the per-card update is one vector loop
+        static constexpr int LANE_WIDTH = 16;
+        using Lanes = std::array<float, LANE_WIDTH>;
+        // Unbalanced lanes' EV tables span every running count reachable from
+        // the IRC in a shoe of `deck_size` decks, so none land out of range
+        MultiCountTracker(float deck_size);
+
+        // {lowest, highest} running count an unbalanced lane can reach: the
+        // IRC plus every negative (or every positive) tag in the shoe
+        static std::pair<float, float> unbalancedCountRange(int lane, int decks);
+
+        // Fix every lane's count bucket for the hand about to be dealt.
+        void beginHand();
+        // Credit one settled wager of the current hand to every lane.
+        void recordResult(double net, double wagered);
+
+        static std::string laneName(int lane);
+        static bool isBalanced(int lane);
+        float getLaneRunningCount(int lane) const;
+        float getLaneCount(int lane) const;
+        const TrueCountHistogram& getLaneEVperTC(int lane) const;
+
+        int getBetSize() override;
+        void setUnitSize(float kellyFraction) override;
+        void updateCount(Card card) override;
+        void updateDeckSize(int num_cards_left) override;
+
+        // The Hi-Lo lane, which also keys the engine's own EV-per-TC table
+        float getTrueCount() const override;
+        float getDecksLeft() const override;
+        float getRunningCount() const override;
+
+        bool shouldAcceptInsurance() const override;
+        Action shouldDeviatefromHard(int playerTotal, Rank dealerUpcard,float true_count) override;
+        Action shouldDeviatefromSplit(Rank playerSplitRank, Rank dealerUpcard,float true_count) override;
+        Action shouldSurrender(int playerTotal, Rank dealerUpcard,float true_count) override;
+
+        Action getHardHandAction(int playerTotal, Rank dealerUpcard,float true_count) override;
+        Action getSoftHandAction(int playerTotal, Rank dealerUpcard) override;
+        Action getSplitAction(Rank playerSplitRank, Rank dealerUpcard,float true_count) override;
+
+        void reset(int deckSize) override;
+        std::string getName() override;
+
+        ~MultiCountTracker() override = default;
+
+    private:
+        alignas(64) Lanes running{};
+        // 1 / decks left on balanced lanes, 1 on unbalanced lanes
+        alignas(64) Lanes scale{};
+        float num_decks_left = 0;
+        // Unbalanced lanes carry their running count, so their range is wider
+        std::array<TrueCountHistogram, LANES> laneStats;
+        std::array<ActionStats*, LANES> handBuckets{};
+        NoStrategy basic;
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef TAGGEDCOUNT_H
+#define TAGGEDCOUNT_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include "Card.h"
+#include "CountTags.h"
+
+namespace CountTags {
+    // 52 / cards left for every shoe depth up to eight decks: a true count is one multiply.
+    inline constexpr int MAX_TABLE_CARDS = 8 * 52;
+
+    constexpr std::array<float, MAX_TABLE_CARDS + 1> buildReciprocalDecks() {
+        std::array<float, MAX_TABLE_CARDS + 1> table{};
+        for (int cards = 1; cards <= MAX_TABLE_CARDS; ++cards) {
+            table[cards] = 52.0f / static_cast<float>(cards);
+        }
+        return table;
+    }
+
+    inline constexpr std::array<float, MAX_TABLE_CARDS + 1> RECIPROCAL_DECKS = buildReciprocalDecks();
+
+    // Smallest multiplier that makes every tag an integer (2 for Wong Halves)
+    constexpr int tagScale(const Table& tags) {
+        for (float tag : tags) {
+            if (tag != static_cast<float>(static_cast<int>(tag))) {
+                return 2;
+            }
+        }
+        return 1;
+    }
+}
+
+// Count state of one tag-table system. The running count is an integer (tags
+// are pre-scaled so Halves stays exact) and moves by one table add per card.
+// Balanced systems report running count per deck left; unbalanced systems
+// start at IRCPerDeck * decks and report the running count itself, which is
+// what their indices are keyed on.
+template <const CountTags::Table& Tags, bool Balanced, int IRCPerDeck = 0>
+class TaggedCount {
+    public:
+        static constexpr int SCALE = CountTags::tagScale(Tags);
+
+        explicit TaggedCount(int decks = 0) { reset(decks); }
+
+        void add(Card card) { running += TAGS[card.getCode()]; }
+        void setCardsLeft(int cards) { cardsLeft = cards; }
+        void reset(int decks) {
+            running = IRCPerDeck * decks * SCALE;
+            cardsLeft = decks * 52;
+        }
+
+        float runningCount() const { return static_cast<float>(running) / SCALE; }
+        float trueCount() const {
+            if constexpr (Balanced) {
+                return static_cast<float>(running) * reciprocalDecks() / SCALE;
+            } else {
+                return runningCount();
+            }
+        }
+        float decksLeft() const { return static_cast<float>(cardsLeft) / 52.0f; }
+        // Every trueCount() an unbalanced system can report over a shoe
+        static std::pair<float, float> countRange(int decks) {
+            static_assert(!Balanced, "a balanced true count has no fixed range");
+            return CountTags::runningCountRange(Tags, IRCPerDeck, decks);
+        }
+
+    private:
+        static constexpr std::array<std::int8_t, Card::CODE_COUNT> scaledTags() {
+            std::array<std::int8_t, Card::CODE_COUNT> table{};
+            for (int code = 0; code < Card::CODE_COUNT; ++code) {
+                table[code] = static_cast<std::int8_t>(Tags[code] * SCALE);
+            }
+            return table;
+        }
+        static constexpr std::array<std::int8_t, Card::CODE_COUNT> TAGS = scaledTags();
+
+        float reciprocalDecks() const {
+            return cardsLeft <= CountTags::MAX_TABLE_CARDS ? CountTags::RECIPROCAL_DECKS[cardsLeft]
+                                                           : 52.0f / static_cast<float>(cardsLeft);
+        }
+
+        int running = 0;
+        int cardsLeft = 0;
+};
+
+#endif
@@ -4,26 +4,27 @@
 #include "Card.h"
 #include "action.h"
 #include "CountingStrategy.h"
+#include "TaggedCount.h"
+#include "BetRamp.h"
 #include "BasicStrategy.h"
 
-class HiLoStrategy : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
+class HiLoStrategy final : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
     private:
-        float true_count = 0;
-        float running_count = 0;
-        float num_decks_left = 0;
+        TaggedCount<CountTags::HI_LO, true> count;
         float initial_decks = 0;
-        float unitSize = 25;
-        float kellyFraction = 0.5f; 
         
         static const int INDEX_OFFSET = 2; // Since dealer upcards start from 2
         static constexpr float evPerTC = 0.004854187311f; // Avg slope (2/4/6/8 deck) from 75pen data
         static constexpr float evIntercept = -0.004198997334f; // Avg intercept from 75pen data
         static constexpr float avgVolatility = 1.32f; // Average bet unit per 1 true count for Kelly cal
         static constexpr float PROFITABLE_PLAY_TC_THRESHOLD = 0.5f; // HiLo profitable at TC >= 0.42 (2deck 75pen)
+        BetRamp ramp{evPerTC, evIntercept, avgVolatility, PROFITABLE_PLAY_TC_THRESHOLD, MIN_BET, MAX_BET};
     public:
         HiLoStrategy(float deck_size);
         int getBetSize() override;
         void setUnitSize(float kellyFraction) override;
+        void setInitialBalance(double balance) override;
+        float getUnitSize() const override { return ramp.getUnitSize(); }
         void updateCount(Card card) override;       
         void updateDeckSize(int num_cards_left) override;
         
@@ -5,29 +5,28 @@
 #include "Deck.h"
 #include "action.h"
 #include "CountingStrategy.h"
+#include "TaggedCount.h"
+#include "BetRamp.h"
 #include "BasicStrategy.h"
 
-class MentorStrategy : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
+class MentorStrategy final : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
     private:
-        float true_count = 0;
-        float running_count = 0;
-        float num_decks_left = 0;
+        TaggedCount<CountTags::MENTOR, true> count;
         float initial_decks = 0;
 
-        float unitSize = 25;
-        float kellyFraction;
-        
-
         static const int INDEX_OFFSET = 2; // Since dealer upcards start from 2
         static constexpr float evPerTC = 0.002745999501f; // Avg slope (2/4/6/8 deck) from 75pen data
         static constexpr float evIntercept = -0.004014569844f; // Avg intercept from 75pen data
         static constexpr float avgVolatility = 1.32f;
         static constexpr float PROFITABLE_PLAY_TC_THRESHOLD = 1.0f; // Mentor profitable at TC >= 0.55 (2deck 75pen)
+        BetRamp ramp{evPerTC, evIntercept, avgVolatility, PROFITABLE_PLAY_TC_THRESHOLD, MIN_BET, MAX_BET};
         int getEvenBet() const;
     public:
         MentorStrategy(float deck_size);
         int getBetSize() override;
         void setUnitSize(float kellyFraction) override;
+        void setInitialBalance(double balance) override;
+        float getUnitSize() const override { return ramp.getUnitSize(); }
         void updateCount(Card card) override;       
         void updateDeckSize(int num_cards_left) override;
         
@@ -6,7 +6,7 @@
 #include "action.h"
 #include "BasicStrategy.h"
 
-class NoStrategy : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
+class NoStrategy final : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
     private:
         float num_decks_left = 0;
         int getEvenBet() const;
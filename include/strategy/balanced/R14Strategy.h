@@ -5,16 +5,14 @@
 #include "Deck.h"
 #include "action.h"
 #include "CountingStrategy.h"
+#include "TaggedCount.h"
+#include "BetRamp.h"
 #include "BasicStrategy.h"
 
-class R14Strategy : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
+class R14Strategy final : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
     private:
-        float true_count = 0;
-        float running_count = 0;
-        float num_decks_left = 0;
+        TaggedCount<CountTags::R14, true> count;
         float initial_decks = 0;
-        float unitSize = 25;
-        float kellyFraction = 0.5f;
         
 
         static const int INDEX_OFFSET = 2; // Since dealer upcards start from 2
@@ -22,11 +20,14 @@ class R14Strategy : public CountingStrategy { //in docs note deck size is counte
         static constexpr float evIntercept = -0.003897738281f; // Avg intercept from 75pen data
         static constexpr float avgVolatility = 1.32f;
         static constexpr float PROFITABLE_PLAY_TC_THRESHOLD = 1.0f; // R14 profitable at TC >= 0.89 (2deck 75pen)
+        BetRamp ramp{evPerTC, evIntercept, avgVolatility, PROFITABLE_PLAY_TC_THRESHOLD, MIN_BET, MAX_BET};
         int getEvenBet() const;
     public:
         R14Strategy(float deck_size);
         int getBetSize() override;
         void setUnitSize(float kellyFraction) override;
+        void setInitialBalance(double balance) override;
+        float getUnitSize() const override { return ramp.getUnitSize(); }
         void updateCount(Card card) override;       
         void updateDeckSize(int num_cards_left) override;
         
@@ -4,23 +4,25 @@
 #include "Card.h"
 #include "Deck.h"
 #include "CountingStrategy.h"
+#include "TaggedCount.h"
 #include "BasicStrategy.h"
 
-class UZenIIStrategy : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
+class UZenIIStrategy final : public CountingStrategy { //in docs note deck size is counted 100% accuratly in half size increments
     private:
-        float num_decks_left = 0;
-        float true_count = 0; //initial running count for KO system
+        TaggedCount<CountTags::UZEN_II, false, -4> count;
         float deckStartSize = 0;
         static const int INDEX_OFFSET = 2; // Since dealer upcards start from 2
         int getEvenBet() const;
     public:
         UZenIIStrategy(float deck_size);
         int getBetSize() override;
+        void setUnitSize(float kellyFraction) override;
         void updateCount(Card card) override;       
         void updateDeckSize(int num_cards_left) override;
         float getTrueCount() const override;
         float getDecksLeft() const override;
         float getRunningCount() const override;
+        std::pair<float, float> getTrueCountRange(int decks) const override;
         bool shouldAcceptInsurance() const override;
 
         Action shouldDeviatefromHard(int playerTotal, Rank dealerUpcard,float true_count=0) override;
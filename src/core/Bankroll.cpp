@@ -1,10 +1,12 @@
 #include "Bankroll.h"
 
-double Bankroll::initialBalance = 0.0;
-
 Bankroll::Bankroll(double startBalance) {
     balance = startBalance;
-    initialBalance = startBalance;
+    totalMoneyBet = 0;
+}
+
+void Bankroll::reset(double startBalance) {
+    balance = startBalance;
     totalMoneyBet = 0;
 }
 
@@ -27,7 +29,3 @@ double Bankroll::getTotalMoneyBet() const {
 void Bankroll::addTotalBet(double amount) {
     totalMoneyBet += amount;
 }
-
-double Bankroll::getInitialBalance() {
-    return initialBalance;
-}
@@ -1,25 +1,30 @@
 #include "Deck.h"
 #include <algorithm>
 #include <atomic>
+#include <random>
+#include <stdexcept>
 
 namespace {
     std::atomic<bool> gDeterministicSeedEnabled{false};
     std::atomic<std::uint32_t> gDeterministicSeed{0u};
     std::atomic<std::uint64_t> gRngEpoch{1u};
+
+    std::uint64_t randomDeviceSeed() {
+        std::random_device rd;
+        return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+    }
 }
 
-std::mt19937& Deck::getGlobalRng() {
-    static thread_local std::mt19937 rng;
+ShoeRng& Deck::getGlobalRng() {
+    static thread_local ShoeRng rng;
     static thread_local std::uint64_t localEpoch = 0u;
 
     const std::uint64_t globalEpoch = gRngEpoch.load(std::memory_order_acquire);
     if (localEpoch != globalEpoch) {
         if (gDeterministicSeedEnabled.load(std::memory_order_acquire)) {
-            rng.seed(gDeterministicSeed.load(std::memory_order_relaxed));
+            rng = ShoeRng(ShoeRng::deriveKey(gDeterministicSeed.load(std::memory_order_relaxed), 0u));
         } else {
-            std::random_device rd;
-            std::seed_seq seedData{rd(), rd(), rd(), rd(), rd(), rd(), rd(), rd()};
-            rng.seed(seedData);
+            rng = ShoeRng(randomDeviceSeed());
         }
         localEpoch = globalEpoch;
     }
@@ -27,65 +32,188 @@ std::mt19937& Deck::getGlobalRng() {
     return rng;
 }
 
-Deck::Deck(int deck_size){
+std::uint64_t Deck::getBaseSeed() {
+    if (gDeterministicSeedEnabled.load(std::memory_order_acquire)) {
+        return gDeterministicSeed.load(std::memory_order_relaxed);
+    }
+    static const std::uint64_t processSeed = randomDeviceSeed();
+    return processSeed;
+}
+
+Deck::Deck(int deck_size, ShuffleMode mode) : numDecks(deck_size), rng(getGlobalRng()()), mode(mode) {
     deck.reserve(deck_size * NUM_CARDS_IN_DECK);  // Pre-allocate memory to avoid reallocations
-    
-    for(int i = 0; i < deck_size; i++){
+    fillCanonical();
+    randomize();
+}
+
+void Deck::fillCanonical() {
+    deck.clear();
+    for(int i = 0; i < numDecks; i++){
         for(int rank = 0; rank < NUM_RANK; rank++){
             for(int suit = 0; suit < NUM_SUIT; suit++){
                 deck.emplace_back(Card(static_cast<Rank>(rank),static_cast<Suit>(suit)));  // use emplace back to construct in place, o(1)
             }
         }
     }
+    top = deck.size();
+    recount();
+}
+
+void Deck::recount() {
+    rankCounts.fill(0);
+    tenCount = 0;
+    for (std::size_t i = 0; i < top; ++i) {
+        rankCounts[static_cast<int>(deck[i].getRank())]++;
+        tenCount += deck[i].isWorthTen();
+    }
+}
 
-    shuffle();
+void Deck::remove(Card card) {
+    rankCounts[static_cast<int>(card.getRank())]--;
+    tenCount -= card.isWorthTen();
 }
 
 void Deck::shuffle() {
-    std::shuffle(deck.begin(), deck.end(), getGlobalRng());
+    rng.shuffle(deck.begin(), deck.begin() + top);
+    randomizedFrom = 0;
+}
+
+void Deck::randomize() {
+    if (mode == ShuffleMode::Lazy) {
+        randomizedFrom = top;
+    } else {
+        shuffle();
+    }
+}
+
+Card Deck::draw() {
+    const std::size_t position = --top;
+    if (position < randomizedFrom) {
+        // Fisher-Yates step: the card drawn is uniform over those not yet dealt
+        std::swap(deck[position], deck[rng.bounded(static_cast<std::uint32_t>(position + 1))]);
+        randomizedFrom = position;
+    }
+    remove(deck[position]);
+    return deck[position];
 }
 
 Deck Deck::createTestDeck(std::vector<Card> stackedCards) {
     Deck riggedDeck(0);
     riggedDeck.deck = stackedCards;
+    riggedDeck.top = riggedDeck.deck.size();
+    riggedDeck.randomizedFrom = 0;
+    riggedDeck.recount();
     return riggedDeck;
 } 
 
-std::pair<Card,Card> Deck::deal(){
-    if (deck.size() < 2) {
-        throw std::runtime_error("Not enough cards in deck to deal 39");
+std::optional<std::pair<Card,Card>> Deck::tryDeal(){
+    if (top < 2) {
+        return std::nullopt;
     } 
-    Card first = deck.back();
-    deck.pop_back();
-    Card second = deck.back();
-    deck.pop_back();
+    if (top <= randomizedFrom) {
+        // Two Fisher-Yates steps from one batched draw, same as shuffle()
+        const std::uint32_t size = static_cast<std::uint32_t>(top);
+        std::uint32_t a;
+        std::uint32_t b;
+        rng.bounded2(size, size - 1, a, b);
+        std::swap(deck[size - 1], deck[a]);
+        std::swap(deck[size - 2], deck[b]);
+        top -= 2;
+        randomizedFrom = top;
+        remove(deck[size - 1]);
+        remove(deck[size - 2]);
+        return std::make_pair(deck[size - 1], deck[size - 2]);
+    }
+    Card first = draw();
+    Card second = draw();
+
+    return std::make_pair(first, second);
+}
 
-    return {first,second};
+std::optional<Card> Deck::tryHit(){
+    if (top == 0) {
+        return std::nullopt;
+    }
+    return draw();
+}
+
+std::pair<Card,Card> Deck::deal(){
+    std::optional<std::pair<Card,Card>> cards = tryDeal();
+    if (!cards) {
+        throw std::runtime_error("Not enough cards in deck to deal 39");
+    }
+    return *cards;
 }
 
 Card Deck::hit(){
-    if (deck.empty()) {
+    std::optional<Card> card = tryHit();
+    if (!card) {
         throw std::runtime_error("Deck is empty - cannot hit 62");
     }
+    return *card;
+}
+
+int Deck::getSize(){
+    return top;
+}
 
-    Card val = deck.back();
-    deck.pop_back();
+ShuffleMode Deck::getShuffleMode() const{
+    return mode;
+}
 
-    return val;
+int Deck::remainingOfRank(Rank rank) const{
+    return rankCounts[static_cast<int>(rank)];
 }
 
-int Deck::getSize(){
-    return deck.size();
+int Deck::remainingTens() const{
+    return tenCount;
+}
+
+double Deck::tenDensity() const{
+    if (top == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(tenCount) / top;
 }
 
 Deck Deck::clone() const{
-    Deck copy(0);
-    copy.deck = this->deck;
-    return copy;
+    return *this;
+}
+
+Deck::Mark Deck::mark() const{
+    return top;
+}
+
+void Deck::rewind(Mark position){
+    // Cards above the mark were already randomized when first drawn, so a
+    // replay deals them again in the same order without touching the RNG.
+    for (std::size_t i = top; i < position; ++i) {
+        rankCounts[static_cast<int>(deck[i].getRank())]++;
+        tenCount += deck[i].isWorthTen();
+    }
+    top = position;
 }
 
 void Deck::reset(){
-    std::shuffle(deck.begin(), deck.end(), getGlobalRng());
+    // Rigged test decks have no canonical order, so the undealt cards are reshuffled as-is
+    if (numDecks > 0) {
+        fillCanonical();
+    } else {
+        deck.erase(deck.begin() + top, deck.end());
+        recount();
+    }
+    rng.seek(rng.getStream() + 1);
+    randomize();
+}
+
+void Deck::resetForShoe(std::uint64_t streamKey, std::uint64_t shoeIndex){
+    rng = ShoeRng(streamKey, shoeIndex);
+    fillCanonical();
+    randomize();
+}
+
+std::uint64_t Deck::streamKey(const std::string& tag) {
+    return ShoeRng::deriveKey(getBaseSeed(), ShoeRng::hashTag(tag));
 }
 
 void Deck::setSeed(std::uint32_t seed) {
@@ -1,9 +1,13 @@
 #include "Engine.h"
 #include "Deck.h"
 #include "MonteCarloScenario.h"
+#include "DealerKernel.h"
+#include "RulesPolicy.h"
+#include "TracePolicy.h"
 
 #include <algorithm>
 #include <cmath>
+#include <stdexcept>
 
 static float roundTrueCount(float value) {
     return std::round(value * 2.0f) / 2.0f;
@@ -15,122 +19,292 @@ Engine::Engine(
     Player* player,
     EventBus* eventBus,
     std::map<std::pair<int, int>, std::map<float, DecisionPoint>>& EVresults,
-    std::map<float,ActionStats>* EVperTC
+    TrueCountHistogram* EVperTC
 )
-    : bankroll(gameConfig.wallet), 
-    config(gameConfig), 
+    : Engine(gameConfig, std::move(deck), std::vector<Player*>{player}, eventBus, EVresults, EVperTC)
+{
+}
+
+Engine::Engine(
+    const GameConfig& gameConfig,
+    Deck deck,
+    const std::vector<Player*>& players,
+    EventBus* eventBus,
+    std::map<std::pair<int, int>, std::map<float, DecisionPoint>>& EVresults,
+    TrueCountHistogram* EVperTC
+)
+    : config(gameConfig), 
     deck(std::move(deck)), 
-    player(player),
-    EVperTC(EVperTC ? EVperTC : &EVperTCStorage),
     reporter(eventBus, gameConfig.emitEvents),
-    fixedEngine(config.monteCarloActions,EVresults,gameConfig)
+    fixedEngine(config.monteCarloActions,EVresults,gameConfig),
+    scenarioMatcher(gameConfig.monteCarloScenarios)
 {
+    if (players.empty() || players.size() > MAX_SEATS) {
+        throw std::invalid_argument("A table seats between 1 and 7 players");
+    }
     config.penetrationThreshold = (1-config.penetrationThreshold) * config.numDecks * Deck::NUM_CARDS_IN_DECK;
-    player->setUnitSize(config.kellyFraction);
+    seats.reserve(players.size());
+    for (Player* player : players) {
+        // The seat's own EV-per-TC table spans every count its strategy reports
+        std::pair<float, float> trueCountRange = {TrueCountHistogram::DEFAULT_MIN, TrueCountHistogram::DEFAULT_MAX};
+        if (CountingStrategy* strategy = player->getStrategy()) {
+            strategy->setInitialBalance(config.wallet);
+            trueCountRange = strategy->getTrueCountRange(config.numDecks);
+        }
+        player->setUnitSize(config.kellyFraction);
+        seats.emplace_back(player, dynamic_cast<BotPlayer*>(player), dynamic_cast<MultiCountTracker*>(player->getStrategy()),
+                           config.wallet, seats.empty() ? EVperTC : nullptr, trueCountRange);
+    }
+    seat = &seats.front();
+    insuranceMonteCarlo = isInsuranceMonteCarloActionSet(config);
+    playHandFn = selectPlayHand(config);
 }
 
-static bool isInsuranceMonteCarloActionSet(const GameConfig& config) {
+bool Engine::isInsuranceMonteCarloActionSet(const GameConfig& config) {
     return std::find(config.monteCarloActions.begin(), config.monteCarloActions.end(), Action::InsuranceAccept) != config.monteCarloActions.end() ||
            std::find(config.monteCarloActions.begin(), config.monteCarloActions.end(), Action::InsuranceDecline) != config.monteCarloActions.end();
 }
 
-static bool hasInsuranceScenarios(const GameConfig& config) {
-    for (const auto& scenario : config.monteCarloScenarios) {
-        if (scenario.isInsuranceScenario) {
-            return true;
-        }
+// Plain runs get a play loop with the rules baked in; Monte Carlo runs keep the
+// runtime checks, since the rollout bookkeeping dominates there anyway.
+Engine::PlayHandFn Engine::selectPlayHand(const GameConfig& config) {
+    return config.emitEvents ? selectPlayHand<EventTrace>(config) : selectPlayHand<NullTrace>(config);
+}
+
+template <class Trace>
+Engine::PlayHandFn Engine::selectPlayHand(const GameConfig& config) {
+    if (config.enabelMontiCarlo) {
+        return &Engine::playHand<RuntimeRules, Trace>;
     }
-    return false;
+    static constexpr PlayHandFn staticLoops[8] = {
+        &Engine::playHand<StaticRules<false, false, false>, Trace>,
+        &Engine::playHand<StaticRules<false, false, true>, Trace>,
+        &Engine::playHand<StaticRules<false, true, false>, Trace>,
+        &Engine::playHand<StaticRules<false, true, true>, Trace>,
+        &Engine::playHand<StaticRules<true, false, false>, Trace>,
+        &Engine::playHand<StaticRules<true, false, true>, Trace>,
+        &Engine::playHand<StaticRules<true, true, false>, Trace>,
+        &Engine::playHand<StaticRules<true, true, true>, Trace>,
+    };
+    const int index = (config.dealerHitsSoft17 ? 4 : 0) | (config.doubleAfterSplitAllowed ? 2 : 0) | (config.allowReSplitAces ? 1 : 0);
+    return staticLoops[index];
 }
 
 std::pair<double, double> Engine::runner(){  
     while (deck->getSize() > config.penetrationThreshold ){
-        playHand();
+        (this->*playHandFn)();
     }  
+    const Bankroll& bankroll = seats.front().bankroll;
     return {bankroll.getBalance(), bankroll.getTotalMoneyBet()};
 }
 
+std::vector<std::pair<double, double>> Engine::getSeatResults() const{
+    std::vector<std::pair<double, double>> results;
+    for (const Seat& s : seats) {
+        results.emplace_back(s.bankroll.getBalance(), s.bankroll.getTotalMoneyBet());
+    }
+    return results;
+}
+
+const TrueCountHistogram& Engine::getSeatEVperTC(int seatIndex) const{
+    const Seat& s = seats.at(seatIndex);
+    return s.EVperTC ? *s.EVperTC : s.EVperTCStorage;
+}
+
 FixedEngine Engine::runnerMonte(){  
     while (deck->getSize() > config.penetrationThreshold ){
-        playHand();
+        (this->*playHandFn)();
     }  
     return {fixedEngine};
 }
 
-void Engine::playHand(){
-    player->updateDeckStrategySize(deck->getSize());
-    std::vector<Hand> hands;
+void Engine::resetShoe(){
+    deck->reset();
+    for (Seat& s : seats) {
+        s.bankroll.reset(config.wallet);
+        s.player->getStrategy()->reset(config.numDecks);
+    }
+}
 
-    handTrueCount = roundTrueCount(player->getTrueCount());
-    currentHandBetTotal = 0.0;
+void Engine::loadShoe(const Deck& shoe){
+    *deck = shoe;
+    for (Seat& s : seats) {
+        s.bankroll.reset(config.wallet);
+        s.player->getStrategy()->reset(config.numDecks);
+    }
+}
 
-    try {
+std::pair<double, double> Engine::runShoes(std::uint64_t n){
+    std::pair<double, double> totals = {0, 0};
+    for (std::uint64_t i = 0; i < n; i++){
+        resetShoe();
+        std::pair<double, double> result = runner();
+        totals.first += result.first;
+        totals.second += result.second;
+    }
+    return totals;
+}
 
-    int bet = player->getBetSize();
-    bankroll.withdraw(bet);
-    bankroll.addTotalBet(bet);
-    currentHandBetTotal += bet;
+const FixedEngine& Engine::getMonteCarloResults() const{
+    return fixedEngine;
+}
 
-    Hand dealer = draw_cards();
-    Hand user = draw_cards(bet);
+template <class Rules, class Trace>
+void Engine::playHand(){
+    shoeExhausted = false;
+    holeCardCounted = false;
+    for (Seat& s : seats) {
+        seat = &s;
+        placeBet();
+    }
+    Seat& first = seats.front();
+    seat = &first;
+
+    // A lone seat keeps the historical order (dealer pair, then player pair)
+    // that the rigged test shoes are stacked for.
+    std::optional<Hand> dealerDeal;
+    if (seats.size() == 1) {
+        dealerDeal = draw_cards();
+        first.user = dealerDeal ? draw_cards(first.bet) : std::nullopt;
+    } else {
+        dealerDeal = dealTable();
+    }
+    if (shoeExhausted) {
+        abandonRound();
+        return;
+    }
+    Hand& dealer = *dealerDeal;
+    Hand& user = *first.user;
 
     // Count visible cards
-    player->updateCount(dealer.getCards()[0]);
+    countCard(dealer.getCards()[0]);
 
-    for (const Card& card : user.getCards()) {
-        player->updateCount(card);
+    for (const Seat& s : seats) {
+        for (const Card& card : s.user->getCards()) {
+            countCard(card);
+        }
     }
 
     // Monte Carlo for insurance decisions must run BEFORE the insurance phase.
     // Handle legacy single-action mode
-    if (config.enabelMontiCarlo && isInsuranceMonteCarloActionSet(config) && dealer.getCards().front().getRank() == Rank::Ace) {
+    if (Rules::monteCarlo(config) && insuranceMonteCarlo && dealer.getCards().front().getRank() == Rank::Ace) {
         const std::pair<int, int> cardValues{user.getScore(), dealer.getCards().front().getValue()};
-        if (config.actionValues.count(cardValues)) {
-            fixedEngine.calculateEV(*player, *deck, dealer, user, player->getTrueCount(), cardValues);
+        if (config.actionValues.count(cardValues) && !fixedEngine.calculateEV(*seat->player, *deck, dealer, user, playerTrueCount(), cardValues)) {
+            shoeExhausted = true;
         }
     }
     
     // Handle multi-scenario mode for insurance
-    if (config.enabelMontiCarlo && hasInsuranceScenarios(config) && dealer.getCards().front().getRank() == Rank::Ace) {
+    if (Rules::monteCarlo(config) && scenarioMatcher.hasInsuranceScenarios() && dealer.getCards().front().getRank() == Rank::Ace) {
         const std::pair<int, int> cardValues{user.getScore(), dealer.getCards().front().getValue()};
-        const bool isSoftHand = user.isHandSoft();
-        const bool canSplit = user.checkCanSplit();
-        
-        for (const auto& scenario : config.monteCarloScenarios) {
-            if (scenario.isInsuranceScenario && scenario.appliesTo(cardValues.first, cardValues.second, isSoftHand, canSplit)) {
-                fixedEngine.calculateEVForScenario(*player, *deck, dealer, user, player->getTrueCount(), cardValues, scenario);
-            }
+        const ScenarioMatcher::Mask matches = scenarioMatcher.match(cardValues.first, cardValues.second, user.isHandSoft(), user.checkCanSplit(), true);
+        if (matches && !shoeExhausted &&
+            !fixedEngine.calculateEVForScenarios(*seat->player, *deck, dealer, user, playerTrueCount(), cardValues, matches)) {
+            shoeExhausted = true;
         }
     }
 
-    reporter.reportHand(dealer, "Dealer (showing)", true);
-    if (handleInsurancePhase(dealer,user)){
+    if (shoeExhausted) {
+        abandonRound();
         return;
     }
-    else if (dealerRobberyHandler(dealer,user)){
-        return;
+
+    if constexpr (Trace::enabled) {
+        reporter.reportHand(dealer, "Dealer (showing)", true);
     }
-    else{
-        hands = user_play(dealer,user);
-        evaluateHands(dealer,hands);
+    // Dealer blackjack ends the round for every seat at once
+    bool roundOver = false;
+    for (Seat& s : seats) {
+        seat = &s;
+        roundOver = handleInsurancePhase<Trace>(dealer, *s.user) || roundOver;
     }
+    if (!roundOver) {
+        for (Seat& s : seats) {
+            seat = &s;
+            roundOver = dealerRobberyHandler<Trace>(dealer, *s.user) || roundOver;
+        }
     }
-    catch (const std::runtime_error& err) {
-        const std::string msg = err.what();
-        if (msg.find("Not enough cards") != std::string::npos || msg.find("Deck is empty") != std::string::npos) {
-            bankroll.deposit(currentHandBetTotal);
-            bankroll.addTotalBet(-currentHandBetTotal);
-            *deck = Deck(config.numDecks);
-            player->getStrategy()->reset(config.numDecks);
-            return;
+    if (!roundOver) {
+        for (Seat& s : seats) {
+            seat = &s;
+            s.hands = user_play<Rules, Trace>(dealer, *s.user);
+            if (shoeExhausted) {
+                break;
+            }
+        }
+        if (!shoeExhausted) {
+            evaluateHands<Rules, Trace>(dealer);
         }
-        throw;
+    }
+
+    if (shoeExhausted) {
+        abandonRound();
+    }
+}
+
+// The shoe ran out mid-round: void the round, refund every wager and start a fresh shoe.
+void Engine::abandonRound(){
+    for (Seat& s : seats) {
+        s.bankroll.deposit(s.currentHandBetTotal);
+        s.bankroll.addTotalBet(-s.currentHandBetTotal);
+        s.player->getStrategy()->reset(config.numDecks);
+    }
+    *deck = Deck(config.numDecks, deck->getShuffleMode());
+    shoeExhausted = false;
+}
+
+void Engine::revealHoleCard(Hand& dealer){
+    // Every seat settling against the hole card sees it once, not once per seat
+    if (!holeCardCounted) {
+        countCard(dealer.getCards()[1]);
+        holeCardCounted = true;
     }
 }
 
+void Engine::placeBet(){
+    if (seat->bot) seat->bot->updateDeckStrategySize(deck->getSize()); else seat->player->updateDeckStrategySize(deck->getSize());
+    seat->handTrueCount = roundTrueCount(playerTrueCount());
+    seat->handBin = evTable(*seat).binIndex(seat->handTrueCount);
+    if (seat->tracker) seat->tracker->beginHand();
+    seat->currentHandBetTotal = 0.0;
+    seat->bet = seat->bot ? seat->bot->getBetSize() : seat->player->getBetSize();
+    seat->bankroll.withdraw(seat->bet);
+    seat->bankroll.addTotalBet(seat->bet);
+    seat->currentHandBetTotal += seat->bet;
+    seat->hands.clear();
+}
+
+// Casino order: a card to each seat, dealer up card, second round, hole card.
+std::optional<Hand> Engine::dealTable(){
+    std::optional<Card> firstCards[MAX_SEATS];
+    for (std::size_t i = 0; i < seats.size(); i++) {
+        firstCards[i] = drawCard();
+    }
+    std::optional<Card> upCard = drawCard();
+    for (std::size_t i = 0; i < seats.size(); i++) {
+        std::optional<Card> second = drawCard();
+        if (firstCards[i] && second) {
+            seats[i].user = Hand({*firstCards[i], *second}, seats[i].bet);
+        }
+    }
+    std::optional<Card> holeCard = drawCard();
+    if (shoeExhausted) {
+        return std::nullopt;
+    }
+    return Hand({*upCard, *holeCard}, 0);
+}
+
+std::optional<Card> Engine::drawCard(){
+    std::optional<Card> card = deck->tryHit();
+    if (!card) {
+        shoeExhausted = true;
+    }
+    return card;
+}
+
 std::vector<int> Engine::getPlayerScores(std::vector<Hand>& hands){
     std::vector<int> scores;
-    for (Hand hand: hands){
+    for (const Hand& hand: hands){
         scores.emplace_back(hand.getFinalScore());
     }
     return scores;
@@ -153,85 +327,120 @@ bool Engine::didPlayerGetNaturalBlackjack(std::vector<Hand>& hands){
     return false;
 }
 
+template <class Trace>
 void Engine::NaturalBlackJackHandler(Hand& dealer, Hand& user){
-    std::ostringstream roundSummary;
-    roundSummary << "Natural Blackjack win! " << ". ";
-    bankroll.deposit(user.getBetSize() + user.getBetSize() * config.blackjackPayoutMultiplier);
-    (*EVperTC)[handTrueCount].addResult(user.getBetSize() * config.blackjackPayoutMultiplier, user.getBetSize());
-
-    std::string outcome = "Natural Blackjack win";
-    roundSummary << "Hand " << (1) << ": " << outcome << " (score " << 21 << ", bet " << user.getBetSize() << "); ";
-
-    reporter.reportRoundResult(roundSummary.str());
-    reporter.reportStats(bankroll, *player->getStrategy());
+    seat->bankroll.deposit(user.getBetSize() + user.getBetSize() * config.blackjackPayoutMultiplier);
+    recordResult(user.getBetSize() * config.blackjackPayoutMultiplier, user.getBetSize());
+
+    if constexpr (Trace::enabled) {
+        std::ostringstream roundSummary;
+        roundSummary << "Natural Blackjack win! " << ". ";
+        roundSummary << "Hand " << (1) << ": " << "Natural Blackjack win" << " (score " << 21 << ", bet " << user.getBetSize() << "); ";
+        reporter.reportRoundResult(roundSummary.str());
+        reporter.reportStats(seat->bankroll, *seat->player->getStrategy());
+    }
     return;
 }   
 
-void Engine::evaluateHands(Hand& dealer, std::vector<Hand>& hands){
-    player->updateCount(dealer.getCards()[1]); // Reveal hole card
+template <class Rules, class Trace>
+void Engine::evaluateHands(Hand& dealer){
+    revealHoleCard(dealer);
 
-    std::vector<int> scores = getPlayerScores(hands);
+    // The dealer plays out unless every seat busted or was paid a natural
+    bool dealerPlays = false;
+    for (Seat& s : seats) {
+        const bool naturalWin = didPlayerGetNaturalBlackjack(s.hands) && !dealer.isBlackjack();
+        if (!naturalWin && !didHandsBust(getPlayerScores(s.hands))) {
+            dealerPlays = true;
+        }
+    }
 
-    if(didPlayerGetNaturalBlackjack(hands) && !dealer.isBlackjack()){
-        NaturalBlackJackHandler(dealer, hands[0]);
-        return;
+    if (dealerPlays){
+        dealer_draw<Rules, Trace>(dealer);
+        if (shoeExhausted) {
+            return;
+        }
     }
 
-    if (!didHandsBust(scores)){
-        dealer_draw(dealer, hands);
+    for (Seat& s : seats) {
+        seat = &s;
+        settleHands<Trace>(dealer, s.hands);
+    }
+}
+
+template <class Trace>
+void Engine::settleHands(Hand& dealer, std::vector<Hand>& hands){
+    if(didPlayerGetNaturalBlackjack(hands) && !dealer.isBlackjack()){
+        NaturalBlackJackHandler<Trace>(dealer, hands[0]);
+        return;
     }
 
     int dealer_score = dealer.getFinalScore();
-    std::ostringstream roundSummary;
-    roundSummary << "Dealer score: " << dealer_score << ". ";
 
     for (int i = 0; i < hands.size(); i++){
         Hand& hand = hands[i];
         int score = hand.getFinalScore();
-        std::string outcome = "Push";
 
         if (dealer_score > score){
-            (*EVperTC)[handTrueCount].addResult(hand.getBetSize() * -1, hand.getBetSize());
-            outcome = "Dealer win";
+            recordResult(hand.getBetSize() * -1, hand.getBetSize());
         }
         else if (dealer_score < score){
-            (*EVperTC)[handTrueCount].addResult(hand.getBetSize() * 1, hand.getBetSize());
-            bankroll.deposit(hand.getBetSize() * 2);
-            outcome = "Player win";
+            recordResult(hand.getBetSize() * 1, hand.getBetSize());
+            seat->bankroll.deposit(hand.getBetSize() * 2);
         }
         else if (dealer_score == 0 && score ==0){
-            (*EVperTC)[handTrueCount].addResult(hand.getBetSize() * -1, hand.getBetSize());
-            outcome = "Player bust";
+            recordResult(hand.getBetSize() * -1, hand.getBetSize());
         }
         else {
-            (*EVperTC)[handTrueCount].addResult(0, hand.getBetSize());
-            bankroll.deposit(hand.getBetSize());
+            recordResult(0, hand.getBetSize());
+            seat->bankroll.deposit(hand.getBetSize());
         }
+    }
 
-        roundSummary << "Hand " << (i + 1) << ": " << outcome << " (score " << score << ", bet " << hand.getBetSize() << "); ";
+    if constexpr (Trace::enabled) {
+        std::ostringstream roundSummary;
+        roundSummary << "Dealer score: " << dealer_score << ". ";
+        for (int i = 0; i < hands.size(); i++){
+            int score = hands[i].getFinalScore();
+            roundSummary << "Hand " << (i + 1) << ": " << outcomeLabel(dealer_score, score) << " (score " << score << ", bet " << hands[i].getBetSize() << "); ";
+        }
+        reporter.reportRoundResult(roundSummary.str());
+        reporter.reportStats(seat->bankroll, *seat->player->getStrategy());
     }
+}
 
-    reporter.reportRoundResult(roundSummary.str());
-    reporter.reportStats(bankroll, *player->getStrategy());
+const char* Engine::outcomeLabel(int dealerScore, int playerScore){
+    if (dealerScore > playerScore) return "Dealer win";
+    if (dealerScore < playerScore) return "Player win";
+    if (dealerScore == 0 && playerScore == 0) return "Player bust";
+    return "Push";
 }
 
+template <class Rules, class Trace>
 std::vector<Hand> Engine::user_play(Hand& dealer, Hand& user){
     std::vector<Hand> hands;
     
-    play_hand(dealer, user, hands, false);
+    play_hand<Rules, Trace>(dealer, user, hands, false);
     return hands;
 }
 
+template <class Rules, class Trace>
 void Engine::play_hand(Hand& dealer, Hand& user, std::vector<Hand>& hands, bool has_split_aces, bool has_split){ 
+    if (shoeExhausted) {
+        return;
+    }
     bool game_over = false;
-    const std::string handLabel = has_split_aces ? "Player (split aces)" : "Player";
-    reporter.reportHand(user, handLabel); 
+    const char* handLabel = has_split_aces ? "Player (split aces)" : "Player";
+    if constexpr (Trace::enabled) {
+        reporter.reportHand(user, handLabel);
+    }
 
     const std::pair<int,int> cardValues{user.getScore(), dealer.getCards().front().getValue()};
 
     // Check if we should run monte carlo for this hand (legacy single-action mode).
     // Insurance MC is handled earlier in playHand() (before insurance resolution).
-    bool shouldRunMonteCarlo = config.enabelMontiCarlo && config.actionValues.count(cardValues) && !isInsuranceMonteCarloActionSet(config);
+    const bool monteCarloSeat = Rules::monteCarlo(config) && seat == &seats.front();
+    bool shouldRunMonteCarlo = monteCarloSeat && !insuranceMonteCarlo && config.actionValues.count(cardValues);
     
     // If requirePairForMonteCarlo is set, only run if hand is a splittable pair
     if (shouldRunMonteCarlo && config.requirePairForMonteCarlo && !user.checkCanSplit()) {
@@ -240,47 +449,43 @@ void Engine::play_hand(Hand& dealer, Hand& user, std::vector<Hand>& hands, bool
     
     if (shouldRunMonteCarlo) {
         const bool isSoftHand = user.isHandSoft();
-        if (config.allowSoftHandsInMonteCarlo || !isSoftHand) {
-            fixedEngine.calculateEV(*player, *deck, dealer, user, player->getTrueCount(), cardValues);
+        if ((config.allowSoftHandsInMonteCarlo || !isSoftHand) &&
+            !fixedEngine.calculateEV(*seat->player, *deck, dealer, user, playerTrueCount(), cardValues)) {
+            shoeExhausted = true;
+            return;
         }
     }
     
     // Handle multi-scenario mode for non-insurance scenarios
-    if (config.enabelMontiCarlo && !config.monteCarloScenarios.empty()) {
-        const bool isSoftHand = user.isHandSoft();
-        const bool canSplit = user.checkCanSplit();
-        
-        for (const auto& scenario : config.monteCarloScenarios) {
-            // Skip insurance scenarios (handled in playHand before insurance phase)
-            if (scenario.isInsuranceScenario) {
-                continue;
-            }
-            
-            if (scenario.appliesTo(cardValues.first, cardValues.second, isSoftHand, canSplit)) {
-                fixedEngine.calculateEVForScenario(*player, *deck, dealer, user, player->getTrueCount(), cardValues, scenario);
-            }
+    // (insurance scenarios were handled in playHand before the insurance phase)
+    if (monteCarloSeat) {
+        const ScenarioMatcher::Mask matches = scenarioMatcher.match(cardValues.first, cardValues.second, user.isHandSoft(), user.checkCanSplit(), false);
+        if (matches &&
+            !fixedEngine.calculateEVForScenarios(*seat->player, *deck, dealer, user, playerTrueCount(), cardValues, matches)) {
+            shoeExhausted = true;
+            return;
         }
     }
 
     while(!game_over){
-        Action action = player->getAction(user, dealer, player->getTrueCount());
+        Action action = chooseAction(user, dealer, playerTrueCount());
         
         switch(action)
         {
             case Action::Stand:
-                game_over = standHandler(user, hands, handLabel);
+                game_over = standHandler<Trace>(user, hands, handLabel);
                 break;
             case Action::Hit:
-                game_over = hitHandler(user, hands, handLabel);
+                game_over = hitHandler<Trace>(user, hands, handLabel);
                 break;
             case Action::Double:
-                game_over = doubleHandler(user, hands, handLabel, has_split);
+                game_over = doubleHandler<Rules, Trace>(user, hands, handLabel, has_split);
                 break;
             case Action::Split:
-                game_over = splitHandler(user, dealer, hands, handLabel, has_split_aces, true);
+                game_over = splitHandler<Rules, Trace>(user, dealer, hands, handLabel, has_split_aces, true);
                 break;
             case Action::Surrender:
-                game_over = surrenderHandler(user, hands, handLabel);
+                game_over = surrenderHandler<Trace>(user, hands, handLabel);
                 break;
             case Action::Skip: 
                 break;
@@ -288,48 +493,48 @@ void Engine::play_hand(Hand& dealer, Hand& user, std::vector<Hand>& hands, bool
     }
 }
 
-Hand Engine::draw_cards(int betSize){
-    Hand hand = Hand(deck->deal(), betSize);
-    return hand;
+std::optional<Hand> Engine::draw_cards(int betSize){
+    std::optional<std::pair<Card,Card>> cards = deck->tryDeal();
+    if (!cards) {
+        shoeExhausted = true;
+        return std::nullopt;
+    }
+    return Hand(*cards, betSize);
 }
 
-void Engine::dealer_draw(Hand& dealer, std::vector<Hand>& hands){
-    reporter.reportHand(dealer, "Dealer");
-    // Fix: Check for Hard 17 or > 17. If Soft 17, check rule.
-    bool isSoft17 = dealer.isSoft17();
-    int score = dealer.getScore();
-    
-    if (score > 17 || (score == 17 && !isSoft17) || (isSoft17 && !config.dealerHitsSoft17)) {
-        return;
-    }
-    while (!dealer.isDealerOver() || (dealer.isSoft17() && config.dealerHitsSoft17)) {
-        if (deck->getSize() < 1) {
-            throw std::runtime_error("Not enough cards to draw initial hand 271");
-        }
-        
-        Card c = deck->hit();
-        player->updateCount(c);
-        dealer.addCard(c);
+template <class Rules, class Trace>
+void Engine::dealer_draw(Hand& dealer){
+    if constexpr (Trace::enabled) {
         reporter.reportHand(dealer, "Dealer");
     }
-    return;
+    DealerKernel::play(dealer, Rules::hitSoft17(config),
+        [this]() { return drawCard(); },
+        [this, &dealer](Card card) {
+            countCard(card);
+            if constexpr (Trace::enabled) {
+                reporter.reportHand(dealer, "Dealer");
+            }
+        });
 }
 
 
+template <class Trace>
 bool Engine::handleInsurancePhase(Hand& dealer, Hand& user) {
     if (!canOfferInsurance(dealer)) {
         return false;
     }
 
-    reporter.reportHand(user, "Player");
     bool accepted = askInsurance();
 
-    std::ostringstream oss;
-    oss << "Insurance offered. Strategy " << (accepted ? "accepts" : "declines");
-    reporter.reportMessage(EventType::ActionTaken, oss.str());
-    reporter.reportHand(dealer, "Dealer", true);
+    if constexpr (Trace::enabled) {
+        reporter.reportHand(user, "Player");
+        std::ostringstream oss;
+        oss << "Insurance offered. Strategy " << (accepted ? "accepts" : "declines");
+        reporter.reportMessage(EventType::ActionTaken, oss.str());
+        reporter.reportHand(dealer, "Dealer", true);
+    }
 
-    return resolveInsurance(accepted, dealer, user);
+    return resolveInsurance<Trace>(accepted, dealer, user);
 }
 
 bool Engine::canOfferInsurance(Hand& dealer) {
@@ -337,137 +542,177 @@ bool Engine::canOfferInsurance(Hand& dealer) {
 }
 
 bool Engine::askInsurance() {
-    return player->shouldAcceptInsurance();
+    return seat->player->shouldAcceptInsurance();
 }
 
+template <class Trace>
 bool Engine::resolveInsurance(bool accepted, Hand& dealer, Hand& user) {
     if (accepted) {
-        return handleInsuranceAccepted(dealer, user);
+        return handleInsuranceAccepted<Trace>(dealer, user);
     } else {
-        return handleInsuranceDeclined(dealer, user);
+        return handleInsuranceDeclined<Trace>(dealer, user);
     }
 }
 
+template <class Trace>
 bool Engine::handleInsuranceAccepted(Hand& dealer, Hand& user) {
     bool dealerHasBlackjack = dealer.dealerHiddenTen();
     bool playerHasBlackjack = user.isBlackjack();
 
     // Insurance wager is always 0.5x the main bet.
     const double insuranceWager = user.getBetSize() * INSURANCEBETCOST;
-    bankroll.withdraw(insuranceWager);
-    bankroll.addTotalBet(insuranceWager);
-    currentHandBetTotal += insuranceWager;
+    seat->bankroll.withdraw(insuranceWager);
+    seat->bankroll.addTotalBet(insuranceWager);
+    seat->currentHandBetTotal += insuranceWager;
 
     if (dealerHasBlackjack) {
-        player->updateCount(dealer.getCards()[1]); // Reveal hole card
+        revealHoleCard(dealer);
         
         if (playerHasBlackjack) {
-            bankroll.deposit(user.getBetSize() + (insuranceWager * 3)); // main hand push + insurance payout
-            (*EVperTC)[handTrueCount].addResult(0, user.getBetSize()); // main hand push
-            (*EVperTC)[handTrueCount].addResult(user.getBetSize(), insuranceWager); // insurance wins (+1.0x bet) on 0.5x wager
-            reporter.reportInsuranceResult("Insurance wins: dealer blackjack vs player blackjack");
+            seat->bankroll.deposit(user.getBetSize() + (insuranceWager * 3)); // main hand push + insurance payout
+            recordResult(0, user.getBetSize()); // main hand push
+            recordResult(user.getBetSize(), insuranceWager); // insurance wins (+1.0x bet) on 0.5x wager
+            if constexpr (Trace::enabled) {
+                reporter.reportInsuranceResult("Insurance wins: dealer blackjack vs player blackjack");
+            }
         } else {
-            bankroll.deposit(insuranceWager * 3); // insurance payout (main hand lost)
-            (*EVperTC)[handTrueCount].addResult(-user.getBetSize(), user.getBetSize()); // main hand loss
-            (*EVperTC)[handTrueCount].addResult(user.getBetSize(), insuranceWager); // insurance wins (+1.0x bet) on 0.5x wager
-            reporter.reportInsuranceResult("Insurance wins: dealer blackjack");
+            seat->bankroll.deposit(insuranceWager * 3); // insurance payout (main hand lost)
+            recordResult(-user.getBetSize(), user.getBetSize()); // main hand loss
+            recordResult(user.getBetSize(), insuranceWager); // insurance wins (+1.0x bet) on 0.5x wager
+            if constexpr (Trace::enabled) {
+                reporter.reportInsuranceResult("Insurance wins: dealer blackjack");
+            }
+        }
+        if constexpr (Trace::enabled) {
+            reporter.reportStats(seat->bankroll, *seat->player->getStrategy());
         }
-        reporter.reportStats(bankroll, *player->getStrategy());
         return true; 
     } else {
-        reporter.reportMessage(EventType::ActionTaken, "Insurance accepted automatically: dealer lacked blackjack");
-        (*EVperTC)[handTrueCount].addResult(-insuranceWager, insuranceWager);
+        if constexpr (Trace::enabled) {
+            reporter.reportMessage(EventType::ActionTaken, "Insurance accepted automatically: dealer lacked blackjack");
+        }
+        recordResult(-insuranceWager, insuranceWager);
         return false; // Round continues
     }
 }
 
+template <class Trace>
 bool Engine::handleInsuranceDeclined(Hand& dealer, Hand& user) {
     bool dealerHasBlackjack = dealer.dealerHiddenTen();
     bool playerHasBlackjack = user.isBlackjack();
 
     if (dealerHasBlackjack) {
-        player->updateCount(dealer.getCards()[1]); // Reveal hole card
+        revealHoleCard(dealer);
         if (playerHasBlackjack) {
 
-            bankroll.deposit(user.getBetSize());
-            (*EVperTC)[handTrueCount].addResult(0, user.getBetSize());
-            reporter.reportRoundResult("Dealer blackjack pushes player blackjack (no insurance)");
-            reporter.reportStats(bankroll, *player->getStrategy());
+            seat->bankroll.deposit(user.getBetSize());
+            recordResult(0, user.getBetSize());
+            if constexpr (Trace::enabled) {
+                reporter.reportRoundResult("Dealer blackjack pushes player blackjack (no insurance)");
+                reporter.reportStats(seat->bankroll, *seat->player->getStrategy());
+            }
         } else {
-            (*EVperTC)[handTrueCount].addResult(user.getBetSize() * -1, user.getBetSize());
-            reporter.reportRoundResult("Dealer blackjack; player loses without insurance");
-            reporter.reportStats(bankroll, *player->getStrategy());
+            recordResult(user.getBetSize() * -1, user.getBetSize());
+            if constexpr (Trace::enabled) {
+                reporter.reportRoundResult("Dealer blackjack; player loses without insurance");
+                reporter.reportStats(seat->bankroll, *seat->player->getStrategy());
+            }
         }
         return true; 
     } else {
-        reporter.reportMessage(EventType::ActionTaken, "Insurance declined; dealer lacks blackjack");
+        if constexpr (Trace::enabled) {
+            reporter.reportMessage(EventType::ActionTaken, "Insurance declined; dealer lacks blackjack");
+        }
         return false;
     }
 }
 
+template <class Trace>
 bool Engine::dealerRobberyHandler(Hand& dealer,Hand& user){
     if (dealer.dealerShowsTen() && dealer.dealerHiddenAce()){
-        reporter.reportHand(user, "Player"); 
-        player->updateCount(dealer.getCards()[1]); // Reveal hole card
+        if constexpr (Trace::enabled) {
+            reporter.reportHand(user, "Player");
+        }
+        revealHoleCard(dealer);
         if (!user.isBlackjack()){
             // Lose. Do nothing.
-            (*EVperTC)[handTrueCount].addResult(user.getBetSize() * -1, user.getBetSize());
+            recordResult(user.getBetSize() * -1, user.getBetSize());
         } else {
-             bankroll.deposit(user.getBetSize());
-             (*EVperTC)[handTrueCount].addResult(0, user.getBetSize());
+             seat->bankroll.deposit(user.getBetSize());
+             recordResult(0, user.getBetSize());
+        }
+        if constexpr (Trace::enabled) {
+            reporter.reportDealerFlip(dealer);
+            reporter.reportStats(seat->bankroll, *seat->player->getStrategy());
         }
-        reporter.reportDealerFlip(dealer);
-        reporter.reportStats(bankroll, *player->getStrategy());
         return true;
     }
     return false;
     
 }
 
-bool Engine::standHandler(Hand& user, std::vector<Hand>& hands, std::string handLabel){
+template <class Trace>
+bool Engine::standHandler(Hand& user, std::vector<Hand>& hands, const char* handLabel){
     hands.emplace_back(user);
-    reporter.reportAction(Action::Stand, user, handLabel);
+    if constexpr (Trace::enabled) {
+        reporter.reportAction(Action::Stand, user, handLabel);
+    }
     return true;
 }
 
-bool Engine::hitHandler(Hand& user, std::vector<Hand>& hands, std::string handLabel){
-    Card c = deck->hit();
-    player->updateCount(c);
-    user.addCard(c);
+template <class Trace>
+bool Engine::hitHandler(Hand& user, std::vector<Hand>& hands, const char* handLabel){
+    std::optional<Card> c = drawCard();
+    if (!c) {
+        return true;
+    }
+    countCard(*c);
+    user.addCard(*c);
 
-    reporter.reportAction(Action::Hit, user, handLabel);
+    if constexpr (Trace::enabled) {
+        reporter.reportAction(Action::Hit, user, handLabel);
+    }
 
     if (user.checkOver()) {hands.emplace_back(user); return true;}
 
     return false;
 }
 
-bool Engine::doubleHandler(Hand& user, std::vector<Hand>& hands, std::string handLabel,bool has_split){
-    if (has_split && !config.doubleAfterSplitAllowed){
-        reporter.reportMessage(EventType::ActionTaken, handLabel + " cannot double after split; hits instead");
-        return hitHandler(user, hands, handLabel);
+template <class Rules, class Trace>
+bool Engine::doubleHandler(Hand& user, std::vector<Hand>& hands, const char* handLabel,bool has_split){
+    if (has_split && !Rules::doubleAfterSplit(config)){
+        if constexpr (Trace::enabled) {
+            reporter.reportMessage(EventType::ActionTaken, std::string(handLabel) + " cannot double after split; hits instead");
+        }
+        return hitHandler<Trace>(user, hands, handLabel);
     }
 
     // Deduct additional bet
-    bankroll.withdraw(user.getBetSize());
-    bankroll.addTotalBet(user.getBetSize());
-    currentHandBetTotal += user.getBetSize();
+    seat->bankroll.withdraw(user.getBetSize());
+    seat->bankroll.addTotalBet(user.getBetSize());
+    seat->currentHandBetTotal += user.getBetSize();
 
     user.doubleBet();
-    Card card = deck->hit();
-    player->updateCount(card);
-    user.addCard(card);
+    std::optional<Card> card = drawCard();
+    if (!card) {
+        return true;
+    }
+    countCard(*card);
+    user.addCard(*card);
     hands.emplace_back(user);
 
-    reporter.reportAction(Action::Double, user, handLabel);
+    if constexpr (Trace::enabled) {
+        reporter.reportAction(Action::Double, user, handLabel);
+    }
     return true;
 }
 
-bool Engine::splitHandler(Hand& user, Hand& dealer, std::vector<Hand>& hands, std::string handLabel, bool has_split_aces,bool has_split){
+template <class Rules, class Trace>
+bool Engine::splitHandler(Hand& user, Hand& dealer, std::vector<Hand>& hands, const char* handLabel, bool has_split_aces,bool has_split){
      // Check if we're splitting Aces
     bool splitting_aces = (user.peekFrontCard() == Rank::Ace);
 
-    if (splitting_aces && has_split_aces && !config.allowReSplitAces){
+    if (splitting_aces && has_split_aces && !Rules::reSplitAces(config)){
         // Resplitting aces not allowed: just add the hand and stop.
         hands.emplace_back(user);
         return true;
@@ -477,46 +722,53 @@ bool Engine::splitHandler(Hand& user, Hand& dealer, std::vector<Hand>& hands, st
     user.popLastCard();
 
     // Deduct bet for new hand
-    bankroll.withdraw(user2.getBetSize());
-    bankroll.addTotalBet(user2.getBetSize());
-    currentHandBetTotal += user2.getBetSize();
+    seat->bankroll.withdraw(user2.getBetSize());
+    seat->bankroll.addTotalBet(user2.getBetSize());
+    seat->currentHandBetTotal += user2.getBetSize();
 
-    Card card1 = deck->hit();
-    player->updateCount(card1);
-    user.addCard(card1);
-
-    Card card2 = deck->hit();
-    player->updateCount(card2);
-    user2.addCard(card2);
+    std::optional<Card> card1 = drawCard();
+    std::optional<Card> card2 = card1 ? drawCard() : std::nullopt;
+    if (!card2) {
+        return true;
+    }
+    countCard(*card1);
+    user.addCard(*card1);
+    countCard(*card2);
+    user2.addCard(*card2);
 
-    reporter.reportSplit(handLabel, user, user2);
+    if constexpr (Trace::enabled) {
+        reporter.reportSplit(handLabel, user, user2);
+    }
 
     if (splitting_aces) {
         // One-card only after splitting aces; allow resplit only when the new hand is still two aces.
-        if (user.isAces() && config.allowReSplitAces) {
-            splitHandler(user, dealer, hands, handLabel, true, true);
+        if (user.isAces() && Rules::reSplitAces(config)) {
+            splitHandler<Rules, Trace>(user, dealer, hands, handLabel, true, true);
         } else {
             hands.emplace_back(user);
         }
 
-        if (user2.isAces() && config.allowReSplitAces) {
-            splitHandler(user2, dealer, hands, handLabel, true, true);
+        if (user2.isAces() && Rules::reSplitAces(config)) {
+            splitHandler<Rules, Trace>(user2, dealer, hands, handLabel, true, true);
         } else {
             hands.emplace_back(user2);
         }
         return true;
     }
 
-    play_hand(dealer, user, hands, false, true);
-    play_hand(dealer, user2, hands, false, true);
+    play_hand<Rules, Trace>(dealer, user, hands, false, true);
+    play_hand<Rules, Trace>(dealer, user2, hands, false, true);
     return true;
 }
 
-bool Engine::surrenderHandler(Hand& user, std::vector<Hand>& hands, std::string handLabel){
+template <class Trace>
+bool Engine::surrenderHandler(Hand& user, std::vector<Hand>& hands, const char* handLabel){
 
-    bankroll.deposit(static_cast<double>(user.getBetSize()) * SURRENDERMULTIPLIER);
-    (*EVperTC)[handTrueCount].addResult(user.getBetSize() * (SURRENDERMULTIPLIER - 1.0), user.getBetSize());
-    reporter.reportAction(Action::Surrender, user, handLabel);
-    reporter.reportStats(bankroll, *player->getStrategy());
+    seat->bankroll.deposit(static_cast<double>(user.getBetSize()) * SURRENDERMULTIPLIER);
+    recordResult(user.getBetSize() * (SURRENDERMULTIPLIER - 1.0), user.getBetSize());
+    if constexpr (Trace::enabled) {
+        reporter.reportAction(Action::Surrender, user, handLabel);
+        reporter.reportStats(seat->bankroll, *seat->player->getStrategy());
+    }
     return true;
 }
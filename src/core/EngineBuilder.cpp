@@ -153,7 +153,7 @@ EngineBuilder& EngineBuilder::setMonteCarloScenarios(const std::vector<MonteCarl
     return *this;
 }
 
-EngineBuilder& EngineBuilder::setEVperTC(std::map<float,ActionStats>& values) {
+EngineBuilder& EngineBuilder::setEVperTC(TrueCountHistogram& values) {
     EVperTC = &values;
     return *this;
 }
@@ -162,3 +162,8 @@ Engine EngineBuilder::build(Player* player) {
     Engine engine(gameConfig, *deck, player, eventBus, EVresults, EVperTC);
     return engine;
 }
+
+Engine EngineBuilder::build(const std::vector<Player*>& players) {
+    Engine engine(gameConfig, *deck, players, eventBus, EVresults, EVperTC);
+    return engine;
+}
@@ -3,49 +3,157 @@
 #include "Engine.h"
 #include "ActionStats.h"
 #include "MonteCarloScenario.h"
+#include "DealerKernel.h"
 
 #include <fstream>
 #include <iomanip>
 #include <filesystem>
 #include <limits>
 #include <cmath>
+#include <array>
+#include <cstdint>
+
+namespace {
+    constexpr int ACTION_COUNT = static_cast<int>(Action::InsuranceDecline) + 1;
+
+    // A rollout records one weight-1 result, into whichever slot the hand ended in
+    bool rolloutPayout(const DecisionPoint& rollout, double& payout) {
+        payout = 0.0;
+        int hands = 0;
+        for (const ActionStats* stats : {&rollout.hitStats, &rollout.standStats, &rollout.doubleStats, &rollout.splitStats,
+                                         &rollout.surrenderStats, &rollout.insuranceAcceptStats, &rollout.insuranceDeclineStats}) {
+            payout += stats->totalPayout;
+            hands += stats->handsPlayed;
+        }
+        return hands > 0;
+    }
+
+    // Creates the parent directory; the stream is closed when anything fails
+    std::ofstream openResultsFile(const std::string& filename, std::ios::openmode mode = std::ios::out) {
+        std::filesystem::path outPath(filename);
+        if (outPath.has_parent_path()) {
+            std::error_code ec;
+            std::filesystem::create_directories(outPath.parent_path(), ec);
+            if (ec) {
+                std::cerr << "Failed to create directory " << outPath.parent_path().string()
+                          << ": " << ec.message() << std::endl;
+                return {};
+            }
+        }
+
+        std::ofstream out(outPath, mode | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to open " << outPath.string() << " for writing results." << std::endl;
+        }
+        return out;
+    }
+}
 
 FixedEngine::FixedEngine() {}
-FixedEngine::FixedEngine(std::vector<Action> monteCarloActions,std::map<std::pair<int, int>, std::map<float, DecisionPoint>> EVresults, const GameConfig& gameConfig) : monteCarloActions(monteCarloActions), EVresults(EVresults), config(gameConfig) {}
+FixedEngine::FixedEngine(std::vector<Action> monteCarloActions,std::map<std::pair<int, int>, std::map<float, DecisionPoint>> EVresults, const GameConfig& gameConfig) : monteCarloActions(monteCarloActions), EVresults(EVresults), scenarioResults(gameConfig.monteCarloScenarios), config(gameConfig) {}
 
-void FixedEngine::calculateEV(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount,std::pair<int,int> cardValues) {
+bool FixedEngine::calculateEV(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount,std::pair<int,int> cardValues) {
+    const Deck::Mark start = deck.mark();
     for (Action forcedAction : monteCarloActions) {
         Hand simDealer = dealer;
         Hand simUser = user;
-        Deck simDeck = deck.clone();
         std::vector<Hand> hands;
+        shoeExhausted = false;
 
-        playForcedHand(player, simDeck, simDealer, simUser, hands, forcedAction, false, false,trueCount);
+        playForcedHand(player, deck, simDealer, simUser, hands, forcedAction, false, false,trueCount);
         Hand evalDealer = simDealer;
-        evaluateHand(simDeck, evalDealer, hands, trueCount, forcedAction,cardValues, simUser.getBetSize());
-
+        if (!shoeExhausted) {
+            DecisionPoint& decisionPoint = EVresults[cardValues][std::round(trueCount * 2.0f) / 2.0f];
+            evaluateHand(deck, evalDealer, hands, forcedAction, simUser.getBetSize(), decisionPoint);
+        }
+        deck.rewind(start);
+        if (shoeExhausted) {
+            return false;
+        }
     }
+    return true;
+}
+
+bool FixedEngine::calculateEVForScenario(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount, 
+                                          std::pair<int,int> cardValues, int scenarioId) {
+    return calculateEVForScenarios(player, deck, dealer, user, trueCount, cardValues, ScenarioMatcher::Mask{1} << scenarioId);
 }
 
-void FixedEngine::calculateEVForScenario(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount, 
-                                          std::pair<int,int> cardValues, const MonteCarloScenario& scenario) {
-    for (Action forcedAction : scenario.actions) {
+bool FixedEngine::calculateEVForScenarios(Player& player, Deck& deck, Hand& dealer, Hand& user, float trueCount,
+                                           std::pair<int,int> cardValues, ScenarioMatcher::Mask scenarios) {
+    // Where each matching scenario records, which forced actions it compares
+    // and the two it pairs (-1 when it lists fewer than two)
+    std::array<DecisionPoint*, ScenarioMatcher::MAX_SCENARIOS> targets;
+    std::array<std::uint32_t, ScenarioMatcher::MAX_SCENARIOS> targetActions;
+    std::array<std::pair<int, int>, ScenarioMatcher::MAX_SCENARIOS> targetPairs;
+    int targetCount = 0;
+    std::uint32_t needed = 0;
+    for (; scenarios; scenarios &= scenarios - 1) {
+        const int id = ScenarioMatcher::firstId(scenarios);
+        DecisionPoint* decisionPoint = scenarioResults.at(id, cardValues, trueCount);
+        if (!decisionPoint) {
+            continue;
+        }
+        const std::vector<Action>& scenarioActions = config.monteCarloScenarios[id].actions;
+        std::uint32_t actions = 0;
+        for (Action action : scenarioActions) {
+            actions |= 1u << static_cast<int>(action);
+        }
+        targets[targetCount] = decisionPoint;
+        targetActions[targetCount] = actions;
+        targetPairs[targetCount] = scenarioActions.size() >= 2
+            ? std::make_pair(static_cast<int>(scenarioActions[0]), static_cast<int>(scenarioActions[1]))
+            : std::make_pair(-1, -1);
+        ++targetCount;
+        needed |= actions;
+    }
+
+    // Each action's result on this occurrence, for pairing once all are in
+    std::array<double, ACTION_COUNT> payouts{};
+    std::uint32_t recorded = 0;
+    const Deck::Mark start = deck.mark();
+    for (; needed; needed &= needed - 1) {
+        const int bit = __builtin_ctz(needed);
+        const Action forcedAction = static_cast<Action>(bit);
         Hand simDealer = dealer;
         Hand simUser = user;
-        Deck simDeck = deck.clone();
         std::vector<Hand> hands;
+        DecisionPoint rollout;
+        shoeExhausted = false;
 
-        playForcedHand(player, simDeck, simDealer, simUser, hands, forcedAction, false, false, trueCount);
+        playForcedHand(player, deck, simDealer, simUser, hands, forcedAction, false, false, trueCount);
         Hand evalDealer = simDealer;
-        evaluateHandForScenario(simDeck, evalDealer, hands, trueCount, forcedAction, cardValues, simUser.getBetSize(), scenario.name);
+        if (!shoeExhausted) {
+            evaluateHand(deck, evalDealer, hands, forcedAction, simUser.getBetSize(), rollout);
+        }
+        deck.rewind(start);
+        if (shoeExhausted) {
+            return false;
+        }
+        for (int i = 0; i < targetCount; ++i) {
+            if (targetActions[i] & (1u << bit)) {
+                targets[i]->merge(rollout);
+            }
+        }
+        if (rolloutPayout(rollout, payouts[bit])) {
+            recorded |= 1u << bit;
+        }
+    }
+
+    for (int i = 0; i < targetCount; ++i) {
+        const auto [first, second] = targetPairs[i];
+        if (first >= 0 && (recorded >> first & 1u) && (recorded >> second & 1u)) {
+            targets[i]->pairedStats.addPair(payouts[first], payouts[second]);
+        }
     }
+    return true;
 }
 
 void FixedEngine::playForcedHand(Player& player, Deck& deck, Hand& dealer, Hand& user,std::vector<Hand>& hands, Action forcedAction,bool has_split_aces, bool has_split,float trueCount){
     bool game_over = false;
     int i = 0;
     Action action = Action::Skip;
-    while(!game_over){
+    while(!game_over && !shoeExhausted){
         if (i == 0 && forcedAction != Action::Skip){
             action = forcedAction;
         }
@@ -90,8 +198,11 @@ bool FixedEngine::standHandler(Hand& user,std::vector<Hand>& hands){
 }
 
 bool FixedEngine::hitHandler(Deck& deck, Hand& user,std::vector<Hand>& hands){
-    Card c = deck.hit();
-    user.addCard(c);
+    std::optional<Card> c = drawCard(deck);
+    if (!c) {
+        return true;
+    }
+    user.addCard(*c);
 
     if (user.checkOver()) {hands.emplace_back(user); return true;}
 
@@ -116,15 +227,17 @@ bool FixedEngine::InsuranceHandler(Player& /*player*/, Deck& /*deck*/, Hand& use
 
 
 bool FixedEngine::doubleHandler(Deck& deck, Hand& user,std::vector<Hand>& hands, bool has_split){
+    std::optional<Card> card = drawCard(deck);
+    if (!card) {
+        return true;
+    }
     if (has_split && !config.doubleAfterSplitAllowed){
-        Card card = deck.hit();
-        user.addCard(card);
+        user.addCard(*card);
         return false;
     }
     else{
         user.doubleBet();
-        Card card = deck.hit();
-        user.addCard(card);
+        user.addCard(*card);
 
         hands.emplace_back(user);
     }
@@ -149,11 +262,13 @@ bool FixedEngine::splitHandler(Player& player, Deck& deck, Hand& user,Hand& deal
     Hand user2 = Hand(user.getLastCard(),user.getBetSize());
     user.popLastCard();
 
-    Card card1 = deck.hit();
-    user.addCard(card1);
-
-    Card card2 = deck.hit();
-    user2.addCard(card2);
+    std::optional<Card> card1 = drawCard(deck);
+    std::optional<Card> card2 = card1 ? drawCard(deck) : std::nullopt;
+    if (!card2) {
+        return true;
+    }
+    user.addCard(*card1);
+    user2.addCard(*card2);
 
     if (splitting_aces) {
         // One-card only after splitting aces; allow resplit only when the new hand is still two aces.
@@ -178,21 +293,20 @@ bool FixedEngine::splitHandler(Player& player, Deck& deck, Hand& user,Hand& deal
     
 }
 
-void FixedEngine::evaluateHand(Deck& deck, Hand& dealer, std::vector<Hand>& hands, float trueCount, Action forcedAction, std::pair<int,int> cardValues, int baseBet) {
-    float bucketedTrueCount = std::round(trueCount * 2.0f) / 2.0f;
-    DecisionPoint& decisionPoint = EVresults[cardValues][bucketedTrueCount];
+void FixedEngine::evaluateHand(Deck& deck, Hand& dealer, std::vector<Hand>& hands, Action forcedAction, int baseBet, DecisionPoint& decisionPoint) {
 
     if (forcedAction == Action::Split) {
         //decisionPoint.splitStats.timesSplit();
         double splitPayout = 0.0;
 
+        // One dealer resolution serves every split hand
+        DealerKernel::resolve(dealer, hands, config.dealerHitsSoft17, [this, &deck]() { return drawCard(deck); }, [](Card) {});
+        if (shoeExhausted) {
+            return;
+        }
+
         for (Hand& hand : hands) {
             int userScore = hand.getFinalScore();
-
-            if (userScore != 0){
-                dealer_draw(deck, dealer);
-            }
-            
             int dealerScore = dealer.getFinalScore();
             float result = 1.0f;
 
@@ -239,6 +353,9 @@ void FixedEngine::evaluateHand(Deck& deck, Hand& dealer, std::vector<Hand>& hand
 
         if (userScore != 0){
             dealer_draw(deck,dealer);
+            if (shoeExhausted) {
+                return;
+            }
         }
         
         int dealerScore = dealer.getFinalScore();
@@ -286,149 +403,22 @@ void FixedEngine::evaluateHand(Deck& deck, Hand& dealer, std::vector<Hand>& hand
 
 }
 
-void FixedEngine::evaluateHandForScenario(Deck& deck, Hand& dealer, std::vector<Hand>& hands, float trueCount, 
-                                           Action forcedAction, std::pair<int,int> cardValues, int baseBet,
-                                           const std::string& scenarioName) {
-    float bucketedTrueCount = std::round(trueCount * 2.0f) / 2.0f;
-    DecisionPoint& decisionPoint = scenarioResults[scenarioName][cardValues][bucketedTrueCount];
-
-    if (forcedAction == Action::Split) {
-        //decisionPoint.splitStats.timesSplit();
-        double splitPayout = 0.0;
-
-        for (Hand& hand : hands) {
-            int userScore = hand.getFinalScore();
-
-            if (userScore != 0){
-                dealer_draw(deck, dealer);
-            }
-            
-            int dealerScore = dealer.getFinalScore();
-            float result = 1.0f;
-
-            if (dealerScore > userScore){
-                result *= -1.0f;
-            }
-            else if (dealerScore < userScore){
-                result *= 1.0f;
-            }
-            else if (dealerScore == 0 && userScore == 0){
-                result *= -1.0f;
-            }
-            else {
-                result *= 0.0f;
-            }
-
-            double betMultiplier = 1.0;
-            if (baseBet > 0) {
-                betMultiplier = static_cast<double>(hand.getBetSize()) / static_cast<double>(baseBet);
-            }
-            splitPayout += result * betMultiplier;
-        }
-
-        decisionPoint.splitStats.addResult(splitPayout);
-        return;
-    }
-    
-    for (Hand& hand : hands) {
-        int userScore = hand.getFinalScore();
-
-        if(hand.isBlackjack() && !dealer.isBlackjack() && hands.size() == 1){
-            if (forcedAction == Action::InsuranceAccept){
-                decisionPoint.insuranceAcceptStats.addResult(1.0f);
-                return;
-            }
-            else if (forcedAction == Action::InsuranceDecline){
-                decisionPoint.insuranceDeclineStats.addResult(1.5f);
-                return;
-            }
-            decisionPoint.standStats.addResult(1.5f);
-            return;
-        }
-
-        if (userScore != 0){
-            dealer_draw(deck, dealer);
-        }
-        
-        int dealerScore = dealer.getFinalScore();
-        float result = 1.0f;
-
-        if (dealerScore > userScore){
-            result *= -1.0f;
-        }
-        else if (dealerScore < userScore){
-            result *= 1.0f;
-        }
-        else if (dealerScore == 0 && userScore == 0){
-            result *= -1.0f;
-        }
-        else {
-            result *= 0.0f;
-        }
-
-        if (forcedAction == Action::Hit) {
-            decisionPoint.hitStats.addResult(result);
-        } else if (forcedAction == Action::Stand) {
-            decisionPoint.standStats.addResult(result);
-        }
-        else if (forcedAction == Action::Double){
-            decisionPoint.doubleStats.addResult(result * 2.0f);
-        }
-        else if (forcedAction == Action::Surrender){
-            decisionPoint.surrenderStats.addResult(-0.5f);
-        }
-        else if (forcedAction == Action::InsuranceAccept){
-            if (dealer.isBlackjack() && hand.isBlackjack() && hands.size() == 1){
-                decisionPoint.insuranceAcceptStats.addResult(1.0f);
-            }
-            else if (dealer.isBlackjack() && !hand.isBlackjack()){
-                decisionPoint.insuranceAcceptStats.addResult(0.0f);
-            }
-            else{
-                decisionPoint.insuranceAcceptStats.addResult(result - 0.5f);
-            }
-        }
-        else if (forcedAction == Action::InsuranceDecline){
-            decisionPoint.insuranceDeclineStats.addResult(result);
-        }
-    }
+void FixedEngine::dealer_draw(Deck& deck,Hand& dealer){
+    DealerKernel::play(dealer, config.dealerHitsSoft17, [this, &deck]() { return drawCard(deck); }, [](Card) {});
 }
 
-void FixedEngine::dealer_draw(Deck& deck,Hand& dealer){
-    // Fix: Check for Hard 17 or > 17. If Soft 17, check rule.
-    bool isSoft17 = dealer.isSoft17();
-    int score = dealer.getScore();
-    
-    if (score > 17 || (score == 17 && !isSoft17) || (isSoft17 && !config.dealerHitsSoft17)) {
-        return;
+std::optional<Card> FixedEngine::drawCard(Deck& deck){
+    std::optional<Card> card = deck.tryHit();
+    if (!card) {
+        shoeExhausted = true;
     }
-    while (!dealer.isDealerOver() || (dealer.isSoft17() && config.dealerHitsSoft17)){
-        if (deck.getSize() < 1) {
-            throw std::runtime_error("Not enough cards to draw initial hand 271");
-        }
-        
-        Card c = deck.hit();
-        dealer.addCard(c);
-    }
-    return;
+    return card;
 }
 
 
 void FixedEngine::savetoCSVResults(const std::string& filename) const {
-    std::filesystem::path outPath(filename);
-    if (outPath.has_parent_path()) {
-        std::error_code ec;
-        std::filesystem::create_directories(outPath.parent_path(), ec);
-        if (ec) {
-            std::cerr << "Failed to create directory " << outPath.parent_path().string()
-                      << ": " << ec.message() << std::endl;
-            return;
-        }
-    }
-
-    std::ofstream out(outPath, std::ios::out | std::ios::trunc);
+    std::ofstream out = openResultsFile(filename);
     if (!out.is_open()) {
-        std::cerr << "Failed to open " << outPath.string() << " for writing results." << std::endl;
         return;
     }
 
@@ -472,67 +462,22 @@ void FixedEngine::savetoCSVResults(const std::string& filename) const {
 }
 
 void FixedEngine::merge(const FixedEngine& other){
-    // Merge weighted ActionStats (weights are totalMoneyWagered)
-    auto accumulate = [](ActionStats& dst, const ActionStats& src) {
-        dst.splitsPlayed += src.splitsPlayed;
-        dst.totalPayout += src.totalPayout;
-        dst.handsPlayed += src.handsPlayed;
-
-        const double dstWeight = dst.totalMoneyWagered;
-        const double srcWeight = src.totalMoneyWagered;
-
-        if (srcWeight <= 0.0) {
-            return;
-        }
-
-        if (dstWeight <= 0.0) {
-            dst.totalMoneyWagered = srcWeight;
-            dst.mean = src.mean;
-            dst.M2 = src.M2;
-            return;
-        }
-
-        const double totalWeight = dstWeight + srcWeight;
-        const double delta = src.mean - dst.mean;
-
-        dst.mean = (dstWeight * dst.mean + srcWeight * src.mean) / totalWeight;
-        dst.M2 = dst.M2 + src.M2 + delta * delta * dstWeight * srcWeight / totalWeight;
-        dst.totalMoneyWagered = totalWeight;
-    };
-
     // Merge legacy EVresults
     for (const auto& [cardValues, tcMapOther] : other.EVresults) {
         auto& currentTcMap = EVresults[cardValues];
         for (const auto& [trueCount, decisionPoint] : tcMapOther) {
-            DecisionPoint& currentPoint = currentTcMap[trueCount];
-
-            accumulate(currentPoint.hitStats, decisionPoint.hitStats);
-            accumulate(currentPoint.standStats, decisionPoint.standStats);
-            accumulate(currentPoint.doubleStats, decisionPoint.doubleStats);
-            accumulate(currentPoint.splitStats, decisionPoint.splitStats);
-            accumulate(currentPoint.surrenderStats, decisionPoint.surrenderStats);
-            accumulate(currentPoint.insuranceAcceptStats, decisionPoint.insuranceAcceptStats);
-            accumulate(currentPoint.insuranceDeclineStats, decisionPoint.insuranceDeclineStats);
+            currentTcMap[trueCount].merge(decisionPoint);
         }
     }
     
-    // Merge multi-scenario results
-    for (const auto& [scenarioName, resultsMapOther] : other.scenarioResults) {
-        auto& currentScenarioMap = scenarioResults[scenarioName];
-        for (const auto& [cardValues, tcMapOther] : resultsMapOther) {
-            auto& currentTcMap = currentScenarioMap[cardValues];
-            for (const auto& [trueCount, decisionPoint] : tcMapOther) {
-                DecisionPoint& currentPoint = currentTcMap[trueCount];
-
-                accumulate(currentPoint.hitStats, decisionPoint.hitStats);
-                accumulate(currentPoint.standStats, decisionPoint.standStats);
-                accumulate(currentPoint.doubleStats, decisionPoint.doubleStats);
-                accumulate(currentPoint.splitStats, decisionPoint.splitStats);
-                accumulate(currentPoint.surrenderStats, decisionPoint.surrenderStats);
-                accumulate(currentPoint.insuranceAcceptStats, decisionPoint.insuranceAcceptStats);
-                accumulate(currentPoint.insuranceDeclineStats, decisionPoint.insuranceDeclineStats);
-            }
-        }
+    // Merge multi-scenario results; a default-constructed engine adopts the other's scenarios
+    if (scenarioResults.scenarioCount() == 0) {
+        scenarioResults = other.scenarioResults;
+        if (config.monteCarloScenarios.empty()) {
+            config.monteCarloScenarios = other.config.monteCarloScenarios;
+        }
+    } else if (other.scenarioResults.scenarioCount() != 0) {
+        scenarioResults.merge(other.scenarioResults);
     }
 }
 
@@ -541,83 +486,37 @@ const std::map<std::pair<int, int>, std::map<float, DecisionPoint>>& FixedEngine
     return EVresults; 
 }
 
-const std::map<std::pair<int, int>, std::map<float, DecisionPoint>>& FixedEngine::getScenarioResults(const std::string& scenarioName) const {
-    static const std::map<std::pair<int, int>, std::map<float, DecisionPoint>> empty;
-    auto it = scenarioResults.find(scenarioName);
-    if (it == scenarioResults.end()) {
-        return empty;
-    }
-    return it->second;
+const ScenarioTensor& FixedEngine::getScenarioResults() const {
+    return scenarioResults;
 }
 
 std::vector<std::string> FixedEngine::getScenarioNames() const {
     std::vector<std::string> names;
-    names.reserve(scenarioResults.size());
-    for (const auto& [name, _] : scenarioResults) {
-        names.push_back(name);
+    names.reserve(scenarioResults.scenarioCount());
+    for (int scenario = 0; scenario < scenarioResults.scenarioCount(); ++scenario) {
+        names.push_back(scenarioResults.scenarioName(scenario));
     }
     return names;
 }
 
 void FixedEngine::saveScenarioResults(const std::string& scenarioName, const std::string& baseFilename) const {
-    auto it = scenarioResults.find(scenarioName);
-    if (it == scenarioResults.end()) {
+    const int scenario = scenarioResults.findScenario(scenarioName);
+    if (scenario < 0) {
         std::cerr << "No results found for scenario: " << scenarioName << std::endl;
         return;
     }
-    
-    std::filesystem::path outPath(baseFilename);
-    if (outPath.has_parent_path()) {
-        std::error_code ec;
-        std::filesystem::create_directories(outPath.parent_path(), ec);
-        if (ec) {
-            std::cerr << "Failed to create directory " << outPath.parent_path().string()
-                      << ": " << ec.message() << std::endl;
-            return;
-        }
-    }
 
-    std::ofstream out(outPath, std::ios::out | std::ios::trunc);
+    std::ofstream out = openResultsFile(baseFilename);
     if (!out.is_open()) {
-        std::cerr << "Failed to open " << outPath.string() << " for writing results." << std::endl;
         return;
     }
+    scenarioResults.writeCSV(scenario, out);
+}
 
-    out << "UserValue,DealerValue,TrueCount,"
-        << "Hit EV,Hit Variance,Stand EV,Stand Variance,Double EV,Double Variance,Split EV,Split Variance,Surrender EV,Surrender Variance,Insurance Accept EV,Insurance Accept Variance,Insurance Decline EV,Insurance Decline Variance,Hands Played" << '\n';
-
-    const auto& resultsMap = it->second;
-    for (const auto& [cardValues, tcMap] : resultsMap) {
-        for (const auto& [trueCount, decisionPoint] : tcMap) {
-            int handsPlayed = decisionPoint.hitStats.handsPlayed;
-            if (handsPlayed == 0) handsPlayed = decisionPoint.standStats.handsPlayed;
-            if (handsPlayed == 0) handsPlayed = decisionPoint.doubleStats.handsPlayed;
-            if (handsPlayed == 0) handsPlayed = decisionPoint.splitStats.handsPlayed;
-            if (handsPlayed == 0) handsPlayed = decisionPoint.surrenderStats.handsPlayed;
-            if (handsPlayed == 0) handsPlayed = decisionPoint.insuranceAcceptStats.handsPlayed;
-            if (handsPlayed == 0) handsPlayed = decisionPoint.insuranceDeclineStats.handsPlayed;
-
-            out << cardValues.first << ','
-                << cardValues.second << ','
-                << std::setprecision(std::numeric_limits<float>::max_digits10) << std::defaultfloat
-                << trueCount << ','
-                << std::fixed << std::setprecision(6)
-                << decisionPoint.hitStats.getEV() << ','
-                << decisionPoint.hitStats.getVariance() << ','
-                << decisionPoint.standStats.getEV() << ','
-                << decisionPoint.standStats.getVariance() << ','
-                << decisionPoint.doubleStats.getEV() << ','
-                << decisionPoint.doubleStats.getVariance() << ','
-                << decisionPoint.splitStats.getEV() << ','
-                << decisionPoint.splitStats.getVariance() << ','
-                << decisionPoint.surrenderStats.getEV() << ','
-                << decisionPoint.surrenderStats.getVariance() << ','
-                << decisionPoint.insuranceAcceptStats.getEV() << ','
-                << decisionPoint.insuranceAcceptStats.getVariance() << ','
-                << decisionPoint.insuranceDeclineStats.getEV() << ','
-                << decisionPoint.insuranceDeclineStats.getVariance() << ','
-                << handsPlayed
-                << '\n';
-        }
+void FixedEngine::saveScenarioBinary(const std::string& filename) const {
+    std::ofstream out = openResultsFile(filename, std::ios::out | std::ios::binary);
+    if (!out.is_open()) {
+        return;
     }
+    scenarioResults.writeBinary(out);
 }
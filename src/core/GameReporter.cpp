@@ -74,7 +74,7 @@ void GameReporter::reportMessage(EventType type, const std::string& message) {
 std::string GameReporter::describeHand(const std::string& label, Hand& hand, bool hideHoleCard) {
     std::ostringstream oss;
     oss << "\n" << label << " hand\n";
-    std::vector<Card> cards = hand.getCards();
+    CardView cards = hand.getCards();
 
     if (cards.empty()){
         oss << "  Cards: <empty>";
@@ -0,0 +1,25 @@
+#include "ScenarioMatcher.h"
+
+#include <stdexcept>
+
+ScenarioMatcher::ScenarioMatcher(const std::vector<MonteCarloScenario>& scenarios) {
+    if (scenarios.size() > MAX_SCENARIOS) {
+        throw std::invalid_argument("ScenarioMatcher supports at most 64 scenarios");
+    }
+    for (std::size_t id = 0; id < scenarios.size(); ++id) {
+        const MonteCarloScenario& scenario = scenarios[id];
+        insurance = insurance || scenario.isInsuranceScenario;
+        for (const auto& [total, upcard] : scenario.cardValues) {
+            if (total < 0 || total >= TOTALS || upcard < 0 || upcard >= UPCARDS) {
+                throw std::invalid_argument("Scenario " + scenario.name + " tracks a hand outside the matcher");
+            }
+            for (bool isSoftHand : {false, true}) {
+                for (bool canSplit : {false, true}) {
+                    if (scenario.appliesTo(total, upcard, isSoftHand, canSplit)) {
+                        table[index(total, upcard, isSoftHand, canSplit, scenario.isInsuranceScenario)] |= Mask{1} << id;
+                    }
+                }
+            }
+        }
+    }
+}
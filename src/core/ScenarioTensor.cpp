@@ -0,0 +1,232 @@
+#include "ScenarioTensor.h"
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+    constexpr char MAGIC[4] = {'B', 'J', 'S', 'T'};
+    constexpr std::uint32_t VERSION = 2;
+
+    static_assert(std::is_trivially_copyable_v<DecisionPoint>, "DecisionPoint is written as raw bytes");
+
+    template <class T>
+    void writeRaw(std::ostream& out, const T* data, std::size_t count) {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+    }
+
+    template <class T>
+    void readRaw(std::istream& in, T* data, std::size_t count) {
+        in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+        if (!in) {
+            throw std::runtime_error("Truncated ScenarioTensor stream");
+        }
+    }
+
+    template <class T>
+    T readValue(std::istream& in) {
+        T value{};
+        readRaw(in, &value, 1);
+        return value;
+    }
+
+    // Hands behind the row: the first action that saw any
+    int handsPlayed(const DecisionPoint& point) {
+        for (const ActionStats* stats : {&point.hitStats, &point.standStats, &point.doubleStats, &point.splitStats,
+                                         &point.surrenderStats, &point.insuranceAcceptStats, &point.insuranceDeclineStats}) {
+            if (stats->handsPlayed != 0) {
+                return stats->handsPlayed;
+            }
+        }
+        return 0;
+    }
+}
+
+ScenarioTensor::ScenarioTensor(float minTrueCount, float maxTrueCount)
+    : firstHalf(static_cast<int>(std::round(minTrueCount * BUCKETS_PER_TC)))
+{
+    const int lastHalf = static_cast<int>(std::round(maxTrueCount * BUCKETS_PER_TC));
+    if (lastHalf < firstHalf) {
+        throw std::invalid_argument("ScenarioTensor true count range is empty");
+    }
+    buckets = lastHalf - firstHalf + 3;
+}
+
+ScenarioTensor::ScenarioTensor(const std::vector<MonteCarloScenario>& scenarios, float minTrueCount, float maxTrueCount)
+    : ScenarioTensor(minTrueCount, maxTrueCount)
+{
+    for (const MonteCarloScenario& scenario : scenarios) {
+        addScenario(scenario.name, {scenario.cardValues.begin(), scenario.cardValues.end()});
+    }
+}
+
+void ScenarioTensor::addScenario(const std::string& name, const std::vector<std::pair<int, int>>& cells) {
+    const std::size_t base = rows.size();
+    rows.resize(base + TOTALS * UPCARDS, -1);
+    std::int32_t next = static_cast<std::int32_t>(points.size() / buckets);
+    for (const auto& [total, upcard] : cells) {
+        if (total < 0 || total >= TOTALS || upcard < 0 || upcard >= UPCARDS) {
+            throw std::invalid_argument("Scenario " + name + " tracks a hand outside the tensor");
+        }
+        std::int32_t& slot = rows[base + static_cast<std::size_t>(total) * UPCARDS + upcard];
+        if (slot < 0) {
+            slot = next++;
+        }
+    }
+    points.resize(static_cast<std::size_t>(next) * buckets);
+    names.push_back(name);
+}
+
+int ScenarioTensor::findScenario(const std::string& name) const {
+    for (int i = 0; i < scenarioCount(); ++i) {
+        if (names[i] == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+std::vector<std::pair<int, int>> ScenarioTensor::trackedCells(int scenario) const {
+    std::vector<std::pair<int, int>> cells;
+    for (int total = 0; total < TOTALS; ++total) {
+        for (int upcard = 0; upcard < UPCARDS; ++upcard) {
+            if (rowIndex(scenario, {total, upcard}) >= 0) {
+                cells.emplace_back(total, upcard);
+            }
+        }
+    }
+    return cells;
+}
+
+bool ScenarioTensor::sameLayout(const ScenarioTensor& other) const {
+    return firstHalf == other.firstHalf && buckets == other.buckets && names == other.names && rows == other.rows;
+}
+
+void ScenarioTensor::merge(const ScenarioTensor& other) {
+    if (!sameLayout(other)) {
+        throw std::invalid_argument("Cannot merge ScenarioTensors with different layouts");
+    }
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        points[i].merge(other.points[i]);
+    }
+    return;
+}
+
+void ScenarioTensor::clear() {
+    std::fill(points.begin(), points.end(), DecisionPoint{});
+    return;
+}
+
+void ScenarioTensor::writeCSV(int scenario, std::ostream& out) const {
+    out << "UserValue,DealerValue,TrueCount,"
+        << "Hit EV,Hit Variance,Stand EV,Stand Variance,Double EV,Double Variance,Split EV,Split Variance,Surrender EV,Surrender Variance,Insurance Accept EV,Insurance Accept Variance,Insurance Decline EV,Insurance Decline Variance,"
+        << "Paired Diff EV,Paired Diff Variance,Paired Covariance,Paired Diff Std Error,Paired Hands,Hands Played" << '\n';
+
+    for (const auto& cardValues : trackedCells(scenario)) {
+        const DecisionPoint* first = row(scenario, cardValues);
+        // Out-of-range buckets stay in the binary export; TrueCount must parse as a number,
+        // so their hands are reported like writeEVperTC's instead of written
+        for (int bucket : {0, buckets - 1}) {
+            if (const int played = handsPlayed(first[bucket])) {
+                std::cerr << names[scenario] << " " << cardValues.first << " vs " << cardValues.second << ": "
+                          << played << " hand(s) " << (isUnderflow(bucket) ? "below " : "above ")
+                          << std::fixed << std::setprecision(1)
+                          << (isUnderflow(bucket) ? getMinTrueCount() : getMaxTrueCount())
+                          << " left out" << std::endl;
+            }
+        }
+        for (int bucket = 1; bucket < buckets - 1; ++bucket) {
+            const DecisionPoint& decisionPoint = first[bucket];
+            const int played = handsPlayed(decisionPoint);
+            if (played == 0) {
+                continue;
+            }
+
+            out << cardValues.first << ','
+                << cardValues.second << ','
+                << std::setprecision(std::numeric_limits<float>::max_digits10) << std::defaultfloat
+                << bucketTrueCount(bucket) << ','
+                << std::fixed << std::setprecision(6)
+                << decisionPoint.hitStats.getEV() << ','
+                << decisionPoint.hitStats.getVariance() << ','
+                << decisionPoint.standStats.getEV() << ','
+                << decisionPoint.standStats.getVariance() << ','
+                << decisionPoint.doubleStats.getEV() << ','
+                << decisionPoint.doubleStats.getVariance() << ','
+                << decisionPoint.splitStats.getEV() << ','
+                << decisionPoint.splitStats.getVariance() << ','
+                << decisionPoint.surrenderStats.getEV() << ','
+                << decisionPoint.surrenderStats.getVariance() << ','
+                << decisionPoint.insuranceAcceptStats.getEV() << ','
+                << decisionPoint.insuranceAcceptStats.getVariance() << ','
+                << decisionPoint.insuranceDeclineStats.getEV() << ','
+                << decisionPoint.insuranceDeclineStats.getVariance() << ','
+                << decisionPoint.pairedStats.getDiffEV() << ','
+                << decisionPoint.pairedStats.getDiffVariance() << ','
+                << decisionPoint.pairedStats.getCovariance() << ','
+                << decisionPoint.pairedStats.getDiffStdError() << ','
+                << decisionPoint.pairedStats.pairs << ','
+                << played
+                << '\n';
+        }
+    }
+}
+
+void ScenarioTensor::writeBinary(std::ostream& out) const {
+    out.write(MAGIC, sizeof(MAGIC));
+    const std::int32_t header[] = {static_cast<std::int32_t>(VERSION), firstHalf, buckets, scenarioCount()};
+    writeRaw(out, header, 4);
+    for (const std::string& name : names) {
+        const std::uint32_t length = static_cast<std::uint32_t>(name.size());
+        writeRaw(out, &length, 1);
+        out.write(name.data(), length);
+    }
+    writeRaw(out, rows.data(), rows.size());
+    const std::uint64_t count = points.size();
+    writeRaw(out, &count, 1);
+    writeRaw(out, points.data(), points.size());
+}
+
+ScenarioTensor ScenarioTensor::readBinary(std::istream& in) {
+    char magic[sizeof(MAGIC)];
+    readRaw(in, magic, sizeof(magic));
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a ScenarioTensor stream");
+    }
+    std::int32_t header[4];
+    readRaw(in, header, 4);
+    if (header[0] != static_cast<std::int32_t>(VERSION) || header[2] < 3 || header[3] < 0) {
+        throw std::runtime_error("Unsupported ScenarioTensor stream");
+    }
+
+    ScenarioTensor tensor;
+    tensor.firstHalf = header[1];
+    tensor.buckets = header[2];
+    tensor.names.resize(header[3]);
+    for (std::string& name : tensor.names) {
+        name.resize(readValue<std::uint32_t>(in));
+        readRaw(in, name.data(), name.size());
+    }
+    tensor.rows.resize(tensor.names.size() * TOTALS * UPCARDS);
+    readRaw(in, tensor.rows.data(), tensor.rows.size());
+    std::uint64_t rowCount = 0;
+    for (std::int32_t r : tensor.rows) {
+        rowCount += r >= 0;
+    }
+    for (std::int32_t r : tensor.rows) {
+        if (r >= static_cast<std::int64_t>(rowCount)) {
+            throw std::runtime_error("ScenarioTensor row out of range");
+        }
+    }
+    if (readValue<std::uint64_t>(in) != rowCount * tensor.buckets) {
+        throw std::runtime_error("ScenarioTensor size does not match its layout");
+    }
+    tensor.points.resize(rowCount * tensor.buckets);
+    readRaw(in, tensor.points.data(), tensor.points.size());
+    return tensor;
+}
@@ -0,0 +1,52 @@
+#include "ShoePipeline.h"
+
+ShoePipeline::ShoePipeline(int numDecks, std::uint64_t streamKey, std::uint64_t shoeCount,
+                           std::uint64_t firstShoe, std::size_t poolSize)
+    : freeSlots(poolSize), readySlots(poolSize), streamKey(streamKey), firstShoe(firstShoe), shoeCount(shoeCount), current(0) {
+    pool.reserve(poolSize);
+    for (std::size_t slot = 0; slot < poolSize; ++slot) {
+        pool.emplace_back(numDecks);
+        freeSlots.tryPush(slot);
+    }
+    producer = std::thread(&ShoePipeline::produce, this);
+}
+
+ShoePipeline::~ShoePipeline() {
+    stopping.store(true, std::memory_order_release);
+    wakeProducer();
+    producer.join();
+}
+
+void ShoePipeline::produce() {
+    for (std::uint64_t shoe = 0; shoe < shoeCount; ++shoe) {
+        std::size_t slot = 0;
+        if (!freeSlots.tryPop(slot)) {
+            std::unique_lock<std::mutex> lock(freeMutex);
+            freeReady.wait(lock, [&]() { return stopping.load(std::memory_order_acquire) || freeSlots.tryPop(slot); });
+            if (stopping.load(std::memory_order_acquire)) {
+                return;
+            }
+        }
+        pool[slot].resetForShoe(streamKey, firstShoe + shoe);
+        // Ready ring has room for the whole pool, so this never fails
+        readySlots.tryPush(slot);
+    }
+}
+
+const Deck& ShoePipeline::next() {
+    if (holding) {
+        freeSlots.tryPush(current);
+        wakeProducer();
+    }
+    while (!readySlots.tryPop(current)) {
+        std::this_thread::yield();
+    }
+    holding = true;
+    return pool[current];
+}
+
+void ShoePipeline::wakeProducer() {
+    // Taking the lock orders this wake-up after a producer that just found the ring empty starts waiting
+    { std::lock_guard<std::mutex> lock(freeMutex); }
+    freeReady.notify_one();
+}
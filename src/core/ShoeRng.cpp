@@ -0,0 +1,69 @@
+#include "ShoeRng.h"
+
+namespace {
+    constexpr std::uint64_t PHILOX_M = 0xD2B74407B1CE6E93ull;
+    constexpr std::uint64_t PHILOX_W = 0x9E3779B97F4A7C15ull;
+    constexpr int PHILOX_ROUNDS = 10;
+
+    std::uint64_t splitmix64(std::uint64_t value) {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+}
+
+ShoeRng::ShoeRng(std::uint64_t key, std::uint64_t stream) : key(key), stream(stream) {}
+
+void ShoeRng::generateBlock() {
+    std::uint64_t ctr0 = block;
+    std::uint64_t ctr1 = stream;
+    std::uint64_t roundKey = key;
+
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        const unsigned __int128 product = static_cast<unsigned __int128>(PHILOX_M) * ctr0;
+        const std::uint64_t hi = static_cast<std::uint64_t>(product >> 64);
+        const std::uint64_t lo = static_cast<std::uint64_t>(product);
+        ctr0 = hi ^ roundKey ^ ctr1;
+        ctr1 = lo;
+        roundKey += PHILOX_W;
+    }
+
+    // Served back to front by operator()
+    buffer[1] = ctr0;
+    buffer[0] = ctr1;
+    buffered = 2;
+    ++block;
+}
+
+void ShoeRng::seek(std::uint64_t newStream, std::uint64_t position) {
+    stream = newStream;
+    block = position / 2;
+    buffered = 0;
+    if (position % 2 != 0) {
+        generateBlock();
+        --buffered;
+    }
+}
+
+std::uint64_t ShoeRng::getKey() const {
+    return key;
+}
+
+std::uint64_t ShoeRng::getStream() const {
+    return stream;
+}
+
+std::uint64_t ShoeRng::deriveKey(std::uint64_t seed, std::uint64_t tag) {
+    return splitmix64(splitmix64(seed) ^ tag);
+}
+
+std::uint64_t ShoeRng::hashTag(const std::string& name) {
+    // FNV-1a, stable across platforms so stream keys survive process boundaries
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
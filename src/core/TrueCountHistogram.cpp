@@ -0,0 +1,40 @@
+#include "TrueCountHistogram.h"
+
+#include <stdexcept>
+
+TrueCountHistogram::TrueCountHistogram(float minTrueCount, float maxTrueCount)
+    : firstHalf(static_cast<int>(std::round(minTrueCount * BINS_PER_TC)))
+{
+    const int lastHalf = static_cast<int>(std::round(maxTrueCount * BINS_PER_TC));
+    if (lastHalf < firstHalf) {
+        throw std::invalid_argument("TrueCountHistogram range is empty");
+    }
+    bins.resize(lastHalf - firstHalf + 3);
+}
+
+int TrueCountHistogram::occupiedBins() const {
+    int occupied = 0;
+    for (const Bin& b : bins) {
+        if (b.stats.handsPlayed > 0) {
+            ++occupied;
+        }
+    }
+    return occupied;
+}
+
+void TrueCountHistogram::merge(const TrueCountHistogram& other) {
+    if (other.firstHalf != firstHalf || other.bins.size() != bins.size()) {
+        throw std::invalid_argument("Cannot merge TrueCountHistograms with different ranges");
+    }
+    for (std::size_t i = 0; i < bins.size(); ++i) {
+        bins[i].stats.merge(other.bins[i].stats);
+    }
+    return;
+}
+
+void TrueCountHistogram::clear() {
+    for (Bin& b : bins) {
+        b.stats = ActionStats{};
+    }
+    return;
+}
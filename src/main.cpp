@@ -21,12 +21,16 @@
 #include <functional>
 #include "LoggingCountingStrategy.h"
 #include "FixedEngine.h"
+#include "ShoePipeline.h"
+#include "TreeReduce.h"
 #include "MentorStrategy.h"
 #include "OmegaIIStrategy.h"
 #include "R14Strategy.h"
 #include "WongHalvesStrategy.h"
 #include "RPCStrategy.h"
 #include "MonteCarloScenario.h"
+#include "MultiCountTracker.h"
+#include "DeviationLoader.h"
 #include <thread>
 #include <filesystem>
 
@@ -67,31 +71,28 @@ void runRTPsims(int numDecksUsed, int iterations, float deckPenetration,std::uni
     //bus.detachAll();
     //bus.registerObserver(&consoleObserver, {EventType::CardsDealt, EventType::ActionTaken, EventType::RoundEnded, EventType::GameStats});
 
-    Deck deck(numDecksUsed);
     BotPlayer robot(false, std::move(strategy)); 
+    const std::uint64_t streamKey = Deck::streamKey(robot.getStrategyName());
+    ShoePipeline shoes(numDecksUsed, streamKey, iterations);
+    Engine hiLoEngine = EngineBuilder()
+                                .withEventBus(&bus)
+                                .setDeckSize(numDecksUsed)
+                                .setDeck(Deck(numDecksUsed))
+                                .setPenetrationThreshold(deckPenetration)
+                                .setInitialWallet(50000)
+                                .setKellyRisk(0.75f)
+                                .enableEvents(false)
+                                .with3To2Payout(true)
+                                .withH17Rules(true)
+                                .allowDoubleAfterSplit(true)
+                                .allowReSplitAces(false)
+                                .build(&robot);
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
     for (int i = 0; i < iterations; i++){
-        deck.reset();
-        robot.resetCount(numDecksUsed);
-
-        std::pair<double, double> profit = {50000, 0};
-
-        Engine hiLoEngine = EngineBuilder()
-                                    .withEventBus(&bus)
-                                    .setDeckSize(numDecksUsed)
-                                    .setDeck(deck)
-                                    .setPenetrationThreshold(deckPenetration)
-                                    .setInitialWallet(50000)
-                                    .setKellyRisk(0.75f)
-                                    .enableEvents(false)
-                                    .with3To2Payout(true)
-                                    .withH17Rules(true)
-                                    .allowDoubleAfterSplit(true)
-                                    .allowReSplitAces(false)
-                                    .build(&robot);
-        profit = hiLoEngine.runner();
+        hiLoEngine.loadShoe(shoes.next());
+        std::pair<double, double> profit = hiLoEngine.runner();
 
         if (i % 10000000 == 0 && i != 0){
             std::cout  << "Completed " << i << " / " << iterations << " iterations." <<std::endl;
@@ -179,34 +180,38 @@ void runRTPsims(int numDecksUsed, int iterations, float deckPenetration,std::uni
 //     std::cout << "  Saved results to " << filename.str() << " (" << duration.count() << "s)" << std::endl;
 // }
 
-// Unified multi-scenario simulation - tracks ALL action comparisons in a single simulation pass
+// Unified multi-scenario simulation - tracks ALL action comparisons in a single simulation pass.
+// The shoes are split into contiguous ranges of one stream, one per worker; each
+// worker keeps a single engine (and so a single accumulator) for its whole range,
+// and the workers' results are tree-reduced once at the end.
 void runUnifiedMonteSims(int numDecksUsed, int iterations, float deckPenetration,
-    std::unique_ptr<CountingStrategy> strategy,
+    const std::function<std::unique_ptr<CountingStrategy>()>& makeStrategy,
     const std::vector<MonteCarloScenario>& scenarios,
-    bool blackJackPayout3to2, bool dealerHits17, bool allowDoubleAfterSplit, bool allowReSplitAces) {
+    bool blackJackPayout3to2, bool dealerHits17, bool allowDoubleAfterSplit, bool allowReSplitAces,
+    int workerCount) {
 
     EventBus& bus = EventBus::getInstance();
-    Deck deck(numDecksUsed);
-    std::map<std::pair<int, int>, std::map<float, DecisionPoint>> EVresults;
-    std::string strategyName = strategy->getName();
+    std::string strategyName = makeStrategy()->getName();
     std::string H17Str = dealerHits17 ? "H17" : "S17";
+    workerCount = std::max(1, std::min(workerCount, iterations));
     
     std::cout << "Running unified simulation for strategy " << strategyName << " (" << H17Str << ")" << std::endl;
-    std::cout << "  Tracking " << scenarios.size() << " scenario(s) simultaneously" << std::endl;
+    std::cout << "  Tracking " << scenarios.size() << " scenario(s) simultaneously on " << workerCount << " worker(s)" << std::endl;
     
-    BotPlayer robot(false, std::move(strategy)); 
-    FixedEngine fixedEngineTotal;
-
+    const std::uint64_t streamKey = Deck::streamKey(strategyName);
+    std::vector<FixedEngine> results(workerCount);
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    for (int i = 0; i < iterations; i++){
-        deck.reset();
-        robot.resetCount(numDecksUsed);
-
+    auto work = [&](int worker) {
+        const std::uint64_t firstShoe = static_cast<std::uint64_t>(iterations) * worker / workerCount;
+        const std::uint64_t shoeCount = static_cast<std::uint64_t>(iterations) * (worker + 1) / workerCount - firstShoe;
+        std::map<std::pair<int, int>, std::map<float, DecisionPoint>> EVresults;
+        BotPlayer robot(false, makeStrategy());
+        ShoePipeline shoes(numDecksUsed, streamKey, shoeCount, firstShoe);
         Engine engine = EngineBuilder()
                             .withEventBus(&bus)
                             .setDeckSize(numDecksUsed)
-                            .setDeck(deck)
+                            .setDeck(Deck(numDecksUsed))
                             .setPenetrationThreshold(deckPenetration)
                             .setInitialWallet(1000)
                             .enableEvents(false)
@@ -219,19 +224,33 @@ void runUnifiedMonteSims(int numDecksUsed, int iterations, float deckPenetration
                             .setEVActions(EVresults)
                             .build(&robot);
 
-        FixedEngine fixedEngine = engine.runnerMonte();
-        fixedEngineTotal.merge(fixedEngine);
+        for (std::uint64_t i = 0; i < shoeCount; i++){
+            engine.loadShoe(shoes.next());
+            engine.runner();
 
-        if (i % 50000000 == 0 && i != 0){
-            std::cout  << "  Completed " << i << " / " << iterations << " iterations. Time: " << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - start_time).count() << "s. Strategy: " << strategyName << std::endl;
+            // Worker 0 reports for everyone; the ranges are the same size
+            if (worker == 0 && i % (50000000 / workerCount + 1) == 0 && i != 0){
+                std::cout  << "  Completed ~" << i * workerCount << " / " << iterations << " iterations. Time: " << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - start_time).count() << "s. Strategy: " << strategyName << std::endl;
+            }
         }
+        results[worker] = engine.getMonteCarloResults();
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (int worker = 0; worker < workerCount; ++worker) {
+        workers.emplace_back(work, worker);
     }
+    for (auto& t : workers) {
+        t.join();
+    }
+    const FixedEngine& total = treeReduce(results);
     
     // Save results for each scenario to separate CSV files
     for (const auto& scenario : scenarios) {
         std::ostringstream filename;
         filename << "stats/" << strategyName << "_" << scenario.name << "_" << numDecksUsed << "_" << H17Str << ".csv";
-        fixedEngineTotal.saveScenarioResults(scenario.name, filename.str());
+        total.saveScenarioResults(scenario.name, filename.str());
         std::cout << "  Saved " << scenario.name << " to " << filename.str() << std::endl;
     }
     
@@ -310,21 +329,56 @@ std::vector<MonteCarloScenario> createAllScenarios() {
     return scenarios;
 }
 
+// One maker per strategy, so every Monte Carlo worker can own its instance
+std::vector<std::function<std::unique_ptr<CountingStrategy>()>> createStrategyMakers(int numDecksUsed) {
+    std::vector<std::function<std::unique_ptr<CountingStrategy>()>> makers;
+    makers.push_back([numDecksUsed]() { return std::make_unique<HiLoStrategy>(numDecksUsed); });
+    //makers.push_back([numDecksUsed]() { return std::make_unique<NoStrategy>(numDecksUsed); });
+    makers.push_back([numDecksUsed]() { return std::make_unique<MentorStrategy>(numDecksUsed); });
+    makers.push_back([numDecksUsed]() { return std::make_unique<RPCStrategy>(numDecksUsed); });
+    makers.push_back([numDecksUsed]() { return std::make_unique<RAPCStrategy>(numDecksUsed); });
+    makers.push_back([numDecksUsed]() { return std::make_unique<ZenCountStrategy>(numDecksUsed); });
+    makers.push_back([numDecksUsed]() { return std::make_unique<R14Strategy>(numDecksUsed); });
+    makers.push_back([numDecksUsed]() { return std::make_unique<OmegaIIStrategy>(numDecksUsed); });
+    makers.push_back([numDecksUsed]() { return std::make_unique<WongHalvesStrategy>(numDecksUsed); });
+    return makers;
+}
+
 // Helper lambda to create all strategies
 auto createStrategies(int numDecksUsed) {
     std::vector<std::unique_ptr<CountingStrategy>> strategies;
-    strategies.push_back(std::make_unique<HiLoStrategy>(numDecksUsed));
-    //strategies.push_back(std::make_unique<NoStrategy>(numDecksUsed));
-    strategies.push_back(std::make_unique<MentorStrategy>(numDecksUsed));
-    strategies.push_back(std::make_unique<RPCStrategy>(numDecksUsed));
-    strategies.push_back(std::make_unique<RAPCStrategy>(numDecksUsed));
-    strategies.push_back(std::make_unique<ZenCountStrategy>(numDecksUsed));
-    strategies.push_back(std::make_unique<R14Strategy>(numDecksUsed));
-    strategies.push_back(std::make_unique<OmegaIIStrategy>(numDecksUsed));
-    strategies.push_back(std::make_unique<WongHalvesStrategy>(numDecksUsed));
+    for (const auto& make : createStrategyMakers(numDecksUsed)) {
+        strategies.push_back(make());
+    }
     return strategies;
 }
 
+void writeEVperTC(const std::string& filename, const TrueCountHistogram& EVperTC) {
+    std::ofstream evFile(filename);
+    evFile << "TrueCount,HandsPlayed,TotalMoneyWagered,TotalPayout,EVPerDollar,StdErrorPerDollar" << std::endl;
+    for (int bin = 0; bin < EVperTC.binCount(); ++bin) {
+        const ActionStats& stats = EVperTC.bin(bin);
+        if (stats.handsPlayed == 0) {
+            continue;
+        }
+        // TrueCount stays numeric: hands beyond the table's range are reported, not written
+        if (EVperTC.isUnderflow(bin) || EVperTC.isOverflow(bin)) {
+            std::cerr << filename << ": " << stats.handsPlayed << " hand(s) "
+                      << (EVperTC.isUnderflow(bin) ? "below " : "above ") << std::fixed << std::setprecision(1)
+                      << (EVperTC.isUnderflow(bin) ? EVperTC.getMinTrueCount() : EVperTC.getMaxTrueCount())
+                      << " left out" << std::endl;
+            continue;
+        }
+        evFile << std::fixed << std::setprecision(1) << EVperTC.binTrueCount(bin) << ",";
+        evFile << stats.handsPlayed << ","
+               << std::fixed << std::setprecision(6) << stats.totalMoneyWagered << ","
+               << std::fixed << std::setprecision(6) << stats.totalPayout << ","
+               << std::fixed << std::setprecision(6) << stats.getEV() << ","
+               << std::fixed << std::setprecision(6) << stats.getStdError()
+               << std::endl;
+    }
+}
+
 // NEW: RTP simulation that stores results to file
 void runRTPsimsWithResults(int numDecksUsed, int iterations, float deckPenetration, 
     std::unique_ptr<CountingStrategy> strategy, bool dealerHits17,
@@ -333,35 +387,33 @@ void runRTPsimsWithResults(int numDecksUsed, int iterations, float deckPenetrati
 
     std::pair<double, double> gameStats = {0, 0};
     EventBus& bus = EventBus::getInstance();
-    Deck deck(numDecksUsed);
     BotPlayer robot(false, std::move(strategy)); 
     std::string strategyName = robot.getStrategy()->getName();
-    std::map<float,ActionStats> EVperTC;
+    const auto [minTrueCount, maxTrueCount] = robot.getStrategy()->getTrueCountRange(numDecksUsed);
+    TrueCountHistogram EVperTC(minTrueCount, maxTrueCount);
+    const std::uint64_t streamKey = Deck::streamKey(strategyName);
+    ShoePipeline shoes(numDecksUsed, streamKey, iterations);
+    Engine engine = EngineBuilder()
+                        .withEventBus(&bus)
+                        .setDeckSize(numDecksUsed)
+                        .setDeck(Deck(numDecksUsed))
+                        .setPenetrationThreshold(deckPenetration)
+                        .setInitialWallet(50000)
+                        .setKellyRisk(kellyFraction)
+                        .enableEvents(false)
+                        .with3To2Payout(blackJackPayout3to2)
+                        .withH17Rules(dealerHits17)
+                        .allowDoubleAfterSplit(allowDoubleAfterSplit)
+                        .allowReSplitAces(allowReSplitAces)
+                        .allowSurrender(surrender)
+                        .setEVperTC(EVperTC)
+                        .build(&robot);
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
     for (int i = 0; i < iterations; i++){
-        deck.reset();
-        robot.resetCount(numDecksUsed);
-
-        std::pair<double, double> profit = {50000, 0};
-
-        Engine engine = EngineBuilder()
-                            .withEventBus(&bus)
-                            .setDeckSize(numDecksUsed)
-                            .setDeck(deck)
-                            .setPenetrationThreshold(deckPenetration)
-                            .setInitialWallet(50000)
-                            .setKellyRisk(kellyFraction)
-                            .enableEvents(false)
-                            .with3To2Payout(blackJackPayout3to2)
-                            .withH17Rules(dealerHits17)
-                            .allowDoubleAfterSplit(allowDoubleAfterSplit)
-                            .allowReSplitAces(allowReSplitAces)
-                            .allowSurrender(surrender)
-                            .setEVperTC(EVperTC)
-                            .build(&robot);
-        profit = engine.runner();
+        engine.loadShoe(shoes.next());
+        std::pair<double, double> profit = engine.runner();
 
         if (i % 5000000 == 0 && i != 0){
             std::cout << strategyName << ": Completed " << i << " / " << iterations << " iterations." << std::endl;
@@ -422,19 +474,65 @@ void runRTPsimsWithResults(int numDecksUsed, int iterations, float deckPenetrati
                << (surrender ? "Surrender" : "NoSurrender") << "_"
                << (blackJackPayout3to2 ? "3to2" : "6to5") << ".csv";
 
-    std::ofstream evFile(evFilename.str());
-    evFile << "TrueCount,HandsPlayed,TotalMoneyWagered,TotalPayout,EVPerDollar,StdErrorPerDollar" << std::endl;
-    for (const auto& entry : EVperTC) {
-        const float trueCount = entry.first;
-        const ActionStats& stats = entry.second;
-        evFile << std::fixed << std::setprecision(1) << trueCount << ","
-               << stats.handsPlayed << ","
-               << std::fixed << std::setprecision(6) << stats.totalMoneyWagered << ","
-               << std::fixed << std::setprecision(6) << stats.totalPayout << ","
-               << std::fixed << std::setprecision(6) << stats.getEV() << ","
-               << std::fixed << std::setprecision(6) << stats.getStdError()
-               << std::endl;
+    writeEVperTC(evFilename.str(), EVperTC);
+}
+
+// Flat-bet basic strategy on one card stream, counted by every system at once.
+// Writes one EV-per-TC file per system (running count buckets for unbalanced ones).
+void runSharedCountSims(int numDecksUsed, int iterations, float deckPenetration, bool dealerHits17,
+    bool allowDoubleAfterSplit, bool allowReSplitAces, bool blackJackPayout3to2) {
+
+    BotPlayer robot(false, std::make_unique<MultiCountTracker>(numDecksUsed));
+    const MultiCountTracker& tracker = static_cast<const MultiCountTracker&>(*robot.getStrategy());
+    ShoePipeline shoes(numDecksUsed, Deck::streamKey("MultiCountTracker"), iterations);
+    Engine engine = EngineBuilder()
+                        .setDeckSize(numDecksUsed)
+                        .setDeck(Deck(numDecksUsed))
+                        .setPenetrationThreshold(deckPenetration)
+                        .setInitialWallet(50000)
+                        .enableEvents(false)
+                        .with3To2Payout(blackJackPayout3to2)
+                        .withH17Rules(dealerHits17)
+                        .allowDoubleAfterSplit(allowDoubleAfterSplit)
+                        .allowReSplitAces(allowReSplitAces)
+                        .build(&robot);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++){
+        engine.loadShoe(shoes.next());
+        engine.runner();
     }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::seconds>(end_time - start_time);
+
+    std::string H17Str = dealerHits17 ? "H17" : "S17";
+    for (int lane = 0; lane < MultiCountTracker::LANES; ++lane) {
+        const std::string strategyName = MultiCountTracker::laneName(lane);
+        std::string evDir = "stats/evPerTC/" + strategyName;
+        fs::create_directories(evDir);
+
+        std::ostringstream evFilename;
+        evFilename << evDir << "/ev_per_tc_" << strategyName << "_" << numDecksUsed << "deck_"
+                   << static_cast<int>(deckPenetration * 100) << "pen_" << H17Str << "_"
+                   << (allowDoubleAfterSplit ? "DAS" : "NoDAS") << "_"
+                   << (allowReSplitAces ? "RAS" : "NoRAS") << "_"
+                   << (blackJackPayout3to2 ? "3to2" : "6to5") << "_basicFlat.csv";
+        writeEVperTC(evFilename.str(), tracker.getLaneEVperTC(lane));
+    }
+
+    std::cout << "=== Shared-stream count tables (" << H17Str << ") ===" << std::endl;
+    std::cout << "  Systems: " << MultiCountTracker::LANES << ", Shoes: " << iterations << std::endl;
+    std::cout << "  Duration: " << duration.count() << "s" << std::endl << std::endl;
+}
+
+// Simulated indices from data/deviation_data, read once and shared by every run
+const DeviationLoader& deviationReports() {
+    static const DeviationLoader reports = [] {
+        DeviationLoader loader;
+        loader.loadDirectory("data/deviation_data");
+        return loader;
+    }();
+    return reports;
 }
 
 // Run RTP simulations for all strategies and save to CSV
@@ -462,6 +560,10 @@ void runAllRTPSimulations(int numDecksUsed, float deckPenetration, int iteration
     std::cout << "Results will be saved to: " << filename << std::endl << std::endl;
     
     auto strategies = createStrategies(numDecksUsed);
+    for (auto& strategy : strategies) {
+        // Games without a report keep the strategy's built-in indices
+        strategy->useDeviations(deviationReports().find(strategy->getName(), dealerHits17, numDecksUsed, deckPenetration));
+    }
     const size_t num_threads = std::min(static_cast<size_t>(4), strategies.size());
     
     std::cout << "Running with " << num_threads << " thread(s)" << std::endl << std::endl;
@@ -511,34 +613,16 @@ void setUpUnifiedSims(int numDecksUsed, float deckPenetration, int iterations, b
     }
     std::cout << std::endl;
     
-    auto strategies = createStrategies(numDecksUsed);
-    // const unsigned int hwThreads = std::max(1u, std::thread::hardware_concurrency());
-    // const size_t maxParallel = std::min(strategies.size(), static_cast<size_t>(hwThreads));
-     
-    const size_t num_threads = 4;
+    // One strategy at a time, its shoes split across every hardware thread
+    const int num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
 
     std::cout << "Using up to " << num_threads << " thread(s)" << std::endl;
 
-    std::vector<std::thread> workers;
-    workers.reserve(num_threads);
-
-    for (auto& strategy : strategies) {
-        workers.emplace_back([&, strat = std::move(strategy)]() mutable {
-            runUnifiedMonteSims(numDecksUsed, iterations, deckPenetration,
-                std::move(strat), scenarios,
-                blackJackPayout3to2, dealerHits17, allowDoubleAfterSplit, allowReSplitAces);
-        });
-
-        if (workers.size() >= num_threads) {
-            for (auto& t : workers) {
-                t.join();
-            }
-            workers.clear();
-        }
-    }
-
-    for (auto& t : workers) {
-        t.join();
+    for (const auto& makeStrategy : createStrategyMakers(numDecksUsed)) {
+        runUnifiedMonteSims(numDecksUsed, iterations, deckPenetration,
+            makeStrategy, scenarios,
+            blackJackPayout3to2, dealerHits17, allowDoubleAfterSplit, allowReSplitAces,
+            num_threads);
     }
     
     std::cout << "\n=== UNIFIED SIMULATIONS COMPLETE (" << H17Str << ") ===" << std::endl;
@@ -1,24 +1,39 @@
 #include "BotPlayer.h"
 
-BotPlayer::BotPlayer(bool allowSurrender, std::unique_ptr<CountingStrategy> strat)
-    : allowSurrender(allowSurrender), strategy(std::move(strat)) {}
+namespace {
+    template <class Alternative, class... Rest>
+    StrategyRef typedRef(CountingStrategy* strat) {
+        if (auto* exact = dynamic_cast<Alternative>(strat)) {
+            return exact;
+        }
+        if constexpr (sizeof...(Rest) > 0) {
+            return typedRef<Rest...>(strat);
+        } else {
+            return strat;
+        }
+    }
 
-CountingStrategy* BotPlayer::getStrategy() {
-    return strategy.get();
-}
+    template <class Generic, class... Concrete>
+    StrategyRef classify(CountingStrategy* strat, std::variant<Generic, Concrete...>*) {
+        return typedRef<Concrete...>(strat);
+    }
 
-void BotPlayer::updateDeckStrategySize(int num_cards_left) {
-    strategy->updateDeckSize(num_cards_left);
-    return;
+    // A double that is no longer allowed falls back to standing on 18-19, else hitting
+    Action playable(Action action, const Hand& user) {
+        if (action != Action::Double || user.checkCanDouble()) {
+            return action;
+        }
+        return user.checkShouldStand() ? Action::Stand : Action::Hit;
+    }
 }
 
-int BotPlayer::getBetSize() {
-    return strategy->getBetSize();
-}
+BotPlayer::BotPlayer(bool allowSurrender, std::unique_ptr<CountingStrategy> strat)
+    : allowSurrender(allowSurrender), strategy(std::move(strat)),
+      typedStrategy(classify(strategy.get(), static_cast<StrategyRef*>(nullptr))),
+      decisions(typedStrategy.index() == 0 ? nullptr : &strategy->getDecisionTable()) {}
 
-void BotPlayer::updateCount(Card card) {
-    strategy->updateCount(card);
-    return;
+CountingStrategy* BotPlayer::getStrategy() {
+    return strategy.get();
 }
 
 void BotPlayer::setUnitSize(float kellyFraction) {
@@ -26,12 +41,8 @@ void BotPlayer::setUnitSize(float kellyFraction) {
     return;
 }
 
-float BotPlayer::getTrueCount() {
-    return strategy->getTrueCount();
-}
-
 bool BotPlayer::shouldAcceptInsurance() {
-    return strategy->shouldAcceptInsurance();
+    return strategy->acceptsInsurance();
 }
 
 void BotPlayer::resetCount(int deckSize) {
@@ -44,50 +55,43 @@ std::string BotPlayer::getStrategyName() {
 }
 
 Action BotPlayer::getAction(Hand& user, Hand& dealer, float trueCount) {
+    return decisions ? decide(*decisions, user, dealer, trueCount) : decide(*strategy, user, dealer, trueCount);
+}
+
+Action BotPlayer::decide(const DecisionTable& table, Hand& user, Hand& dealer, float trueCount) {
+    Rank dealer_card = dealer.peekFrontCard();
+
+    if (user.checkCanDouble() && allowSurrender
+        && table.lookup(DecisionTable::Surrender, user.getScore(), dealer_card, trueCount) == Action::Surrender) {
+        return Action::Surrender;
+    }
+
+    if (user.checkCanSplit()) {
+        return table.lookup(DecisionTable::Pair, static_cast<int>(user.peekFrontCard()), dealer_card, trueCount);
+    }
+
+    const DecisionTable::HandClass handClass = user.isHandSoft() ? DecisionTable::Soft : DecisionTable::Hard;
+    return playable(table.lookup(handClass, user.getScore(), dealer_card, trueCount), user);
+}
+
+Action BotPlayer::decide(CountingStrategy& strat, Hand& user, Hand& dealer, float trueCount) {
     Rank dealer_card = dealer.peekFrontCard();
 
     if(user.checkCanDouble() && allowSurrender){
-        Action action = strategy->shouldSurrender(user.getScore(), dealer_card, trueCount);
+        Action action = strat.shouldSurrender(user.getScore(), dealer_card, trueCount);
         if (action == Action::Surrender) {
             return action;
         }
     }
 
     if(user.checkCanSplit()){
-        return strategy->getSplitAction(user.peekFrontCard(), dealer_card, trueCount);
+        return strat.getSplitAction(user.peekFrontCard(), dealer_card, trueCount);
     }
 
     int playerTotal = user.getScore();
 
     if(user.isHandSoft()){
-        Action action = strategy->getSoftHandAction(playerTotal, dealer_card);
-
-        if (action == Action::Double){
-            if (user.checkCanDouble()){
-                return action;
-            }
-            else if (user.checkShouldStand()){
-                return Action::Stand;
-            }
-            else{
-                return Action::Hit;
-            }
-        }
-        return action;
-    }
-    else{
-        Action action = strategy->getHardHandAction(playerTotal, dealer_card, trueCount);
-        if (action == Action::Double){
-            if (user.checkCanDouble()){
-                return action;
-            }
-            else if(user.checkShouldStand()){
-                return Action::Stand;
-            }
-            else{
-                return Action::Hit;
-            }
-        }
-        return action;
+        return playable(strat.getSoftHandAction(playerTotal, dealer_card), user);
     }
+    return playable(strat.getHardHandAction(playerTotal, dealer_card, trueCount), user);
 }
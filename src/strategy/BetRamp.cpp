@@ -0,0 +1,35 @@
+#include "BetRamp.h"
+
+BetRamp::BetRamp(float evPerTC, float evIntercept, float avgVolatility, float profitableTC, int minBet, int maxBet)
+    : evPerTC(evPerTC), evIntercept(evIntercept), avgVolatility(avgVolatility),
+      profitableTC(profitableTC), minBet(minBet), maxBet(maxBet) {
+    build();
+}
+
+void BetRamp::setInitialBalance(double balance) {
+    initialBalance = balance;
+    build();
+    return;
+}
+
+void BetRamp::setKellyFraction(float fraction) {
+    kellyFraction = fraction;
+    unitSize = (initialBalance * kellyFraction * evPerTC) / avgVolatility;
+    if (unitSize < 1.0f) unitSize = 1.0f;
+    build();
+    return;
+}
+
+void BetRamp::build() {
+    const float interceptUnit = (initialBalance * kellyFraction * evIntercept) / avgVolatility;
+    for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+        const float effectiveTC = static_cast<float>(bucket) / BUCKETS_PER_TC - profitableTC;
+        if (effectiveTC <= 0) {
+            bets[bucket] = minBet;
+            continue;
+        }
+        int bet = std::round((unitSize * effectiveTC + interceptUnit) / (float)minBet) * minBet; // Round to nearest minBet
+        bets[bucket] = std::min(maxBet, std::max(minBet, bet));
+    }
+    return;
+}
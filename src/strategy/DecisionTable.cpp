@@ -0,0 +1,80 @@
+#include "DecisionTable.h"
+#include "CountingStrategy.h"
+#include "DeviationLoader.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    // Counts beyond this are treated as the limit itself when probing
+    constexpr float PROBE_LIMIT = 10000.0f;
+
+    // Maps floats onto unsigned ints in the same order, so bisection can walk
+    // to the exact float at which a comparison flips (e.g. "> 0" vs ">= 0").
+    std::uint32_t orderedKey(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    float fromOrderedKey(std::uint32_t key) {
+        std::uint32_t bits = (key & 0x80000000u) ? (key & 0x7fffffffu) : ~key;
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    template <class Probe>
+    DecisionTable::Entry compile(Probe probe) {
+        DecisionTable::Entry cell;
+        cell.basic = probe(-PROBE_LIMIT);
+        cell.deviation = probe(PROBE_LIMIT);
+        if (cell.basic == cell.deviation) {
+            return cell;
+        }
+        std::uint32_t low = orderedKey(-PROBE_LIMIT);
+        std::uint32_t high = orderedKey(PROBE_LIMIT);
+        while (high - low > 1) {
+            std::uint32_t mid = low + (high - low) / 2;
+            if (probe(fromOrderedKey(mid)) == cell.deviation) {
+                high = mid;
+            } else {
+                low = mid;
+            }
+        }
+        cell.index = fromOrderedKey(high);
+        return cell;
+    }
+}
+
+void DecisionTable::build(CountingStrategy& strategy) {
+    for (int up = 0; up < UPCARDS; ++up) {
+        const Rank upcard = static_cast<Rank>(up);
+        // Hard 4 (a pair of twos) is the lowest total that reaches a decision
+        for (int total = 4; total < TOTALS; ++total) {
+            cells[Hard][total][up] = compile([&](float tc) { return strategy.getHardHandAction(total, upcard, tc); });
+            cells[Surrender][total][up] = compile([&](float tc) { return strategy.shouldSurrender(total, upcard, tc); });
+        }
+        // Soft 12 is only ever a pair of aces, which is played as a pair
+        for (int total = 13; total < TOTALS; ++total) {
+            Entry& cell = cells[Soft][total][up];
+            cell.basic = cell.deviation = strategy.getSoftHandAction(total, upcard);
+        }
+        for (int pair = 0; pair < UPCARDS; ++pair) {
+            const Rank pairRank = static_cast<Rank>(pair);
+            cells[Pair][pair][up] = compile([&](float tc) { return strategy.getSplitAction(pairRank, upcard, tc); });
+        }
+    }
+    if (deviations) {
+        deviations->applyTo(*this);
+    }
+    return;
+}
+
+void DecisionTable::setIndex(HandClass handClass, int total, Rank upcard, float index, Action below, Action atOrAbove) {
+    Entry& cell = cells[handClass][total][static_cast<int>(upcard)];
+    cell.basic = below;
+    cell.deviation = atOrAbove;
+    cell.index = index;
+    return;
+}
@@ -0,0 +1,195 @@
+#include "DeviationLoader.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    // Report columns: Game Config,Strategy,Rules,Decision,Action A,Action B,
+    // Player Value,Dealer Upcard,Deviation TC,Total Hands,Notes
+    constexpr int GAME_COLUMN = 0;
+    constexpr int STRATEGY_COLUMN = 1;
+    constexpr int RULES_COLUMN = 2;
+    constexpr int DECISION_COLUMN = 3;
+    constexpr int ACTION_A_COLUMN = 4;
+    constexpr int ACTION_B_COLUMN = 5;
+    constexpr int PLAYER_COLUMN = 6;
+    constexpr int UPCARD_COLUMN = 7;
+    constexpr int INDEX_COLUMN = 8;
+
+    // The report's two actions for each decision, and how the index splits
+    // them in the table. Insurance (no hand class) sets DeviationSet::insuranceIndex.
+    struct ReportDecision {
+        const char* name;
+        const char* actionA;
+        const char* actionB;
+        DecisionTable::HandClass handClass;
+        Action below;
+        Action atOrAbove;
+    };
+    constexpr ReportDecision DECISIONS[] = {
+        {"Hit_vs_Double", "Double", "Hit", DecisionTable::Hard, Action::Hit, Action::Double},
+        {"Hit_vs_Stand", "Hit", "Stand", DecisionTable::Hard, Action::Hit, Action::Stand},
+        {"Surrender_vs_Hit", "Surrender", "Hit", DecisionTable::Surrender, Action::Skip, Action::Surrender},
+        {"Split_vs_Stand_Pair10s", "Split", "Stand", DecisionTable::Pair, Action::Stand, Action::Split},
+        {"InsuranceAccept_vs_Decline", "Insurance", "Decline", DecisionTable::CLASS_COUNT, Action::InsuranceDecline, Action::InsuranceAccept},
+    };
+
+    const ReportDecision* findDecision(const std::string& name) {
+        for (const ReportDecision& decision : DECISIONS) {
+            if (name == decision.name) {
+                return &decision;
+            }
+        }
+        return nullptr;
+    }
+
+    std::runtime_error rowError(const std::string& path, int row, const std::string& what) {
+        return std::runtime_error(path + " row " + std::to_string(row) + ": " + what);
+    }
+
+    // std::stoi/std::stof, but a malformed field names the report and row
+    template <class T>
+    T parseField(const std::string& field, const std::string& path, int row) {
+        std::size_t used = 0;
+        try {
+            T value;
+            if constexpr (std::is_same_v<T, int>) {
+                value = std::stoi(field, &used);
+            } else {
+                value = std::stof(field, &used);
+            }
+            if (used == field.size()) {
+                return value;
+            }
+        } catch (const std::logic_error&) {
+        }
+        throw rowError(path, row, "cannot parse \"" + field + "\"");
+    }
+
+    std::string setKey(const std::string& strategy, const std::string& rules, const std::string& game) {
+        return strategy + "_" + rules + "_" + game;
+    }
+
+    std::vector<std::string> splitRow(const std::string& line) {
+        std::vector<std::string> fields;
+        std::stringstream row(line);
+        std::string field;
+        while (std::getline(row, field, ',')) {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    // Report upcards are values 2-11; a ten value covers all four ten ranks
+    std::vector<Rank> upcardRanks(int value) {
+        if (value == 11) return {Rank::Ace};
+        if (value == 10) return {Rank::Ten, Rank::Jack, Rank::Queen, Rank::King};
+        if (value >= 2 && value <= 9) return {static_cast<Rank>(value - 2)};
+        return {};
+    }
+}
+
+void DeviationSet::setIndex(DecisionTable::HandClass handClass, int total, Rank upcard, float index, Action below, Action atOrAbove) {
+    cells[handClass][total][static_cast<int>(upcard)] = {index, below, atOrAbove};
+    return;
+}
+
+float DeviationSet::getIndex(DecisionTable::HandClass handClass, int total, Rank upcard) const {
+    return cells[handClass][total][static_cast<int>(upcard)].index;
+}
+
+void DeviationSet::applyTo(DecisionTable& table) const {
+    for (int handClass = 0; handClass < DecisionTable::CLASS_COUNT; ++handClass) {
+        for (int total = 0; total < DecisionTable::TOTALS; ++total) {
+            for (int up = 0; up < DecisionTable::UPCARDS; ++up) {
+                const Crossover& cell = cells[handClass][total][up];
+                if (!std::isnan(cell.index)) {
+                    table.setIndex(static_cast<DecisionTable::HandClass>(handClass), total, static_cast<Rank>(up),
+                                   cell.index, cell.below, cell.atOrAbove);
+                }
+            }
+        }
+    }
+    return;
+}
+
+void DeviationLoader::loadReport(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open deviation report " + path);
+    }
+
+    std::string line;
+    std::getline(file, line); // header
+    int row = 1;
+    while (std::getline(file, line)) {
+        ++row;
+        const std::vector<std::string> fields = splitRow(line);
+        if (fields.size() <= INDEX_COLUMN) {
+            continue;
+        }
+        DeviationSet& set = sets[setKey(fields[STRATEGY_COLUMN], fields[RULES_COLUMN], fields[GAME_COLUMN])];
+        const ReportDecision* decision = findDecision(fields[DECISION_COLUMN]);
+        if (!decision) {
+            continue;
+        }
+        // Which action applies on which side of the index comes from the
+        // decision; a report with the pair swapped would load it inverted
+        if (fields[ACTION_A_COLUMN] != decision->actionA || fields[ACTION_B_COLUMN] != decision->actionB) {
+            throw rowError(path, row, fields[DECISION_COLUMN] + " expects actions " + decision->actionA + "," + decision->actionB
+                                      + " but the report has " + fields[ACTION_A_COLUMN] + "," + fields[ACTION_B_COLUMN]);
+        }
+        if (fields[INDEX_COLUMN] == "N/A") {
+            continue; // no crossover inside the simulated range
+        }
+        const float index = parseField<float>(fields[INDEX_COLUMN], path, row);
+
+        if (decision->handClass == DecisionTable::CLASS_COUNT) {
+            set.insuranceIndex = index;
+            continue;
+        }
+
+        const int playerValue = parseField<int>(fields[PLAYER_COLUMN], path, row);
+        for (Rank upcard : upcardRanks(parseField<int>(fields[UPCARD_COLUMN], path, row))) {
+            if (decision->handClass == DecisionTable::Pair) {
+                // Ten-value pairs: the report's player value covers all four ten ranks
+                for (Rank ten : upcardRanks(10)) {
+                    set.setIndex(decision->handClass, static_cast<int>(ten), upcard, index, decision->below, decision->atOrAbove);
+                }
+            } else {
+                set.setIndex(decision->handClass, playerValue, upcard, index, decision->below, decision->atOrAbove);
+            }
+        }
+    }
+    return;
+}
+
+int DeviationLoader::loadDirectory(const std::string& directory) {
+    namespace fs = std::filesystem;
+    int loaded = 0;
+    if (!fs::is_directory(directory)) {
+        return loaded;
+    }
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.is_regular_file() && name.rfind("deviation_report_", 0) == 0 && entry.path().extension() == ".csv") {
+            loadReport(entry.path().string());
+            ++loaded;
+        }
+    }
+    return loaded;
+}
+
+const DeviationSet* DeviationLoader::find(const std::string& strategyName, bool dealerHitsSoft17, int numDecks, float penetration) const {
+    auto it = sets.find(setKey(strategyName, dealerHitsSoft17 ? "H17" : "S17", gameKey(numDecks, penetration)));
+    return it == sets.end() ? nullptr : &it->second;
+}
+
+std::string DeviationLoader::gameKey(int numDecks, float penetration) {
+    return std::to_string(numDecks) + "deck_" + std::to_string(static_cast<int>(std::lround(penetration * 100))) + "pen";
+}
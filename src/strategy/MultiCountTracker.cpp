@@ -0,0 +1,173 @@
+#include "MultiCountTracker.h"
+#include "CountTags.h"
+#include <cmath>
+
+namespace {
+    struct LaneSpec {
+        const CountTags::Table* tags;
+        const char* name;
+        float initialCountPerDeck;
+    };
+
+    // Balanced systems first; names match each strategy's getName()
+    constexpr LaneSpec LANE_SPECS[MultiCountTracker::LANES] = {
+        {&CountTags::HI_LO,       "HiLoStrategy",        0},
+        {&CountTags::ZEN,         "ZenCountStrategy",    0},
+        {&CountTags::MENTOR,      "MentorStrategy",      0},
+        {&CountTags::OMEGA_II,    "OmegaIIStrategy",     0},
+        {&CountTags::R14,         "R14Strategy",         0},
+        {&CountTags::RAPC,        "RAPCStrategy",        0},
+        {&CountTags::RPC,         "RPCStrategy",         0},
+        {&CountTags::WONG_HALVES, "WongHalvesStrategy",  0},
+        {&CountTags::KO,          "KoStrategy",         -4},
+        {&CountTags::UZEN_II,     "UZenIIStrategy",     -4},
+        {&CountTags::USTON_SS,    "UstonSSStrategy",    -4},
+        {&CountTags::RED_7,       "Red7Strategy",       -2},
+        {&CountTags::KISS_III,    "KISSIIIStrategy",    -2},
+    };
+
+    // Tag tables transposed so one card code addresses all lanes at once
+    constexpr std::array<MultiCountTracker::Lanes, Card::CODE_COUNT> buildLaneTags() {
+        std::array<MultiCountTracker::Lanes, Card::CODE_COUNT> table{};
+        for (int code = 0; code < Card::CODE_COUNT; ++code) {
+            for (int lane = 0; lane < MultiCountTracker::LANES; ++lane) {
+                table[code][lane] = (*LANE_SPECS[lane].tags)[code];
+            }
+        }
+        return table;
+    }
+
+    alignas(64) constexpr std::array<MultiCountTracker::Lanes, Card::CODE_COUNT> LANE_TAGS = buildLaneTags();
+}
+
+MultiCountTracker::MultiCountTracker(float deck_size) : basic(deck_size) {
+    for (int lane = BALANCED_LANES; lane < LANES; ++lane) {
+        const auto [lowest, highest] = unbalancedCountRange(lane, static_cast<int>(deck_size));
+        laneStats[lane] = TrueCountHistogram(lowest, highest);
+    }
+    reset(static_cast<int>(deck_size));
+    decisions.build(*this);
+}
+
+std::pair<float, float> MultiCountTracker::unbalancedCountRange(int lane, int decks) {
+    return CountTags::runningCountRange(*LANE_SPECS[lane].tags, LANE_SPECS[lane].initialCountPerDeck, decks);
+}
+
+void MultiCountTracker::beginHand() {
+    for (int lane = 0; lane < LANES; ++lane) {
+        handBuckets[lane] = &laneStats[lane].at(running[lane] * scale[lane]);
+    }
+}
+
+void MultiCountTracker::recordResult(double net, double wagered) {
+    for (ActionStats* bucket : handBuckets) {
+        if (bucket) {
+            bucket->addResult(net, wagered);
+        }
+    }
+}
+
+std::string MultiCountTracker::laneName(int lane) {
+    return LANE_SPECS[lane].name;
+}
+
+bool MultiCountTracker::isBalanced(int lane) {
+    return lane < BALANCED_LANES;
+}
+
+float MultiCountTracker::getLaneRunningCount(int lane) const {
+    return running[lane];
+}
+
+float MultiCountTracker::getLaneCount(int lane) const {
+    return running[lane] * scale[lane];
+}
+
+const TrueCountHistogram& MultiCountTracker::getLaneEVperTC(int lane) const {
+    return laneStats[lane];
+}
+
+int MultiCountTracker::getBetSize() {
+    return basic.getBetSize();
+}
+
+void MultiCountTracker::setUnitSize(float kellyFraction) {
+    // Flat betting: the bet never depends on the count
+    (void)kellyFraction;
+    return;
+}
+
+void MultiCountTracker::updateCount(Card card) {
+    const Lanes& tags = LANE_TAGS[card.getCode()];
+    for (int lane = 0; lane < LANE_WIDTH; ++lane) {
+        running[lane] += tags[lane];
+    }
+    return;
+}
+
+void MultiCountTracker::updateDeckSize(int num_cards_left) {
+    num_decks_left = static_cast<float>(num_cards_left) / 52.0f;
+    if (num_decks_left > 0) {
+        const float perDeck = 1.0f / num_decks_left;
+        for (int lane = 0; lane < BALANCED_LANES; ++lane) {
+            scale[lane] = perDeck;
+        }
+    }
+    return;
+}
+
+float MultiCountTracker::getTrueCount() const {
+    return getLaneCount(0);
+}
+
+float MultiCountTracker::getDecksLeft() const {
+    return num_decks_left;
+}
+
+float MultiCountTracker::getRunningCount() const {
+    return running[0];
+}
+
+bool MultiCountTracker::shouldAcceptInsurance() const {
+    return false;
+}
+
+Action MultiCountTracker::shouldDeviatefromHard(int playerTotal, Rank dealerUpcard, float trueCount) {
+    return Action::Skip;
+}
+
+Action MultiCountTracker::shouldDeviatefromSplit(Rank playerSplitRank, Rank dealerUpcard, float trueCount) {
+    return Action::Skip;
+}
+
+Action MultiCountTracker::shouldSurrender(int playerTotal, Rank dealerUpcard, float trueCount) {
+    return Action::Skip;
+}
+
+Action MultiCountTracker::getHardHandAction(int playerTotal, Rank dealerUpcard, float trueCount) {
+    return basic.getHardHandAction(playerTotal, dealerUpcard, trueCount);
+}
+
+Action MultiCountTracker::getSoftHandAction(int playerTotal, Rank dealerUpcard) {
+    return basic.getSoftHandAction(playerTotal, dealerUpcard);
+}
+
+Action MultiCountTracker::getSplitAction(Rank playerSplitRank, Rank dealerUpcard, float trueCount) {
+    return basic.getSplitAction(playerSplitRank, dealerUpcard, trueCount);
+}
+
+void MultiCountTracker::reset(int deckSize) {
+    running.fill(0.0f);
+    scale.fill(1.0f);
+    for (int lane = 0; lane < LANES; ++lane) {
+        running[lane] = LANE_SPECS[lane].initialCountPerDeck * deckSize;
+    }
+    num_decks_left = static_cast<float>(deckSize);
+    updateDeckSize(deckSize * 52);
+    handBuckets.fill(nullptr);
+    basic.reset(deckSize);
+}
+
+std::string MultiCountTracker::getName() {
+    return "MultiCountTracker";
+}
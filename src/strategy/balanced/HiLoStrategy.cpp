@@ -1,5 +1,5 @@
 #include "HiLoStrategy.h"
-#include "Bankroll.h"
+#include "CountTags.h"
 #include <cmath>
 
 namespace {
@@ -9,78 +9,53 @@ namespace {
 }
 
 HiLoStrategy::HiLoStrategy(float deck_size){
-    num_decks_left = deck_size;
+    count.reset(static_cast<int>(deck_size));
     initial_decks = deck_size;
+    decisions.build(*this);
 }
 
 
 int HiLoStrategy::getBetSize() {
-    float effectiveTC = true_count - PROFITABLE_PLAY_TC_THRESHOLD;
-    if (effectiveTC <= 0){
-        return MIN_BET;
-    }
-
-    float interceptUnit = (Bankroll::getInitialBalance() * kellyFraction * evIntercept) / avgVolatility;
-    int bet = std::round((unitSize * effectiveTC + interceptUnit) / (float)MIN_BET) * MIN_BET; // Round to nearest MIN_BET
-    bet = std::max(MIN_BET, bet);
-    return std::min(getMaxBet(), bet);
+    return ramp.betFor(count.trueCount());
 }
 
 void HiLoStrategy::setUnitSize(float inputKellyFraction) {
-    kellyFraction = inputKellyFraction;
-    unitSize = (Bankroll::getInitialBalance() * kellyFraction * evPerTC) / avgVolatility;
-    if (unitSize < 1.0f) unitSize = 1.0f;
+    ramp.setKellyFraction(inputKellyFraction);
     return;
 }
 
-void HiLoStrategy::updateCount(Card card) {
-    Rank rank = card.getRank();
-    int score = static_cast<int>(rank) + INDEX_OFFSET;
-
-    constexpr int lowerCard = 6;
-    constexpr int upperCard = 10;
-
-    if (score <= lowerCard){
-        running_count += 1.0f;
-    }
-    else if (score >= upperCard){
-        running_count -= 1.0f;
-    }
+void HiLoStrategy::setInitialBalance(double balance) {
+    ramp.setInitialBalance(balance);
+    return;
+}
 
-    float raw = running_count / num_decks_left;
-    true_count = raw;// round when we go back to human level rtp sims
+void HiLoStrategy::updateCount(Card card) {
+    count.add(card);
     return;
 }
 
 void HiLoStrategy::updateDeckSize(int num_cards_left){
-    num_decks_left = static_cast<float>(num_cards_left) / 52.0f;
-
-    // Recompute true count whenever deck size changes so future bets/decisions use latest shoe depth
-    if (num_decks_left > 0) {
-        float raw = running_count / num_decks_left;
-        true_count = raw;
-    }
-
+    count.setCardsLeft(num_cards_left);
     return;
 }
 
 float HiLoStrategy::getTrueCount() const{
-    return true_count;
+    return count.trueCount();
 }
 
 float HiLoStrategy::getRunningCount() const{
-    return running_count;
+    return count.runningCount();
 }
 
 float HiLoStrategy::getDecksLeft() const{
-    return num_decks_left;
+    return count.decksLeft();
 }
 
 bool HiLoStrategy::shouldAcceptInsurance() const{
     const bool useSixDeck = initial_decks >= 5.5f;
     // 2-deck 65% pen: TC crossover = 2.5, 6-deck 80% pen: TC crossover = 3.0
     const float insuranceThreshold = useSixDeck ? 3.0f : 2.5f;
-    if (true_count >= insuranceThreshold){
+    if (count.trueCount() >= insuranceThreshold){
         return true;
     }
     return false;
@@ -267,10 +242,12 @@ Action HiLoStrategy::getSplitAction(Rank playerSplitRank, Rank dealerUpcard, flo
 }
 
 void HiLoStrategy::reset(int deckSize){
-    running_count = 0;
-    true_count = 0;
-    num_decks_left = deckSize;
-    initial_decks = deckSize;
+    count.reset(deckSize);
+    if (initial_decks != deckSize) {
+        // Indices are chosen by deck count
+        initial_decks = deckSize;
+        decisions.build(*this);
+    }
     return;
 }
 
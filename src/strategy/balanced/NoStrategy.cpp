@@ -3,6 +3,7 @@
 
 NoStrategy::NoStrategy(float deck_size){
     num_decks_left = deck_size;
+    decisions.build(*this);
     return;
 }
 
@@ -1,10 +1,11 @@
 #include "RAPCStrategy.h"
-#include "Bankroll.h"
+#include "CountTags.h"
 #include <cmath>
 
 RAPCStrategy::RAPCStrategy(float deck_size){
-    num_decks_left = deck_size;
+    count.reset(static_cast<int>(deck_size));
     initial_decks = deck_size;
+    decisions.build(*this);
 }
 
 int RAPCStrategy::getEvenBet() const {
@@ -12,96 +13,46 @@ int RAPCStrategy::getEvenBet() const {
 }
 
 int RAPCStrategy::getBetSize() {
-    float effectiveTC = true_count - PROFITABLE_PLAY_TC_THRESHOLD;
-    if (effectiveTC <= 0){
-        return MIN_BET;
-    }
-
-    float interceptUnit = (Bankroll::getInitialBalance() * kellyFraction * evIntercept) / avgVolatility;
-    int bet = std::round((unitSize * effectiveTC + interceptUnit) / (float)MIN_BET) * MIN_BET; // Round to nearest MIN_BET
-    bet = std::max(MIN_BET, bet);
-    return std::min(getMaxBet(), bet);
+    return ramp.betFor(count.trueCount());
 }
 
 void RAPCStrategy::setUnitSize(float inputKellyFraction) {
-    kellyFraction = inputKellyFraction;
-    unitSize = (Bankroll::getInitialBalance() * kellyFraction * evPerTC) / avgVolatility;
-    if (unitSize < 1.0f) unitSize = 1.0f;
+    ramp.setKellyFraction(inputKellyFraction);
     return;
 }
 
-void RAPCStrategy::updateCount(Card card) {
-    int score = card.getValue();
-
-    switch (score)
-    {
-    case 2:
-        running_count += 2;
-        break;
-    case 3:
-        running_count += 3;
-        break;
-    case 4:
-        running_count += 3;
-        break;
-    case 5:
-        running_count += 4;
-        break;
-    case 6: 
-        running_count += 3;
-        break;
-    case 7:
-        running_count += 2;
-        break;
-    case 8:
-        running_count += 0;
-        break;
-    case 9:         
-        running_count -= 1;
-        break;
-    case 10:
-        running_count -= 3;
-        break;
-    case 11: //Ace
-        running_count -= 4;
-        break;
-    
-    default:
-        break;
-    }
+void RAPCStrategy::setInitialBalance(double balance) {
+    ramp.setInitialBalance(balance);
+    return;
+}
 
-    float raw = running_count / num_decks_left;
-    true_count = raw;
+void RAPCStrategy::updateCount(Card card) {
+    count.add(card);
     return;
 }
 
 void RAPCStrategy::updateDeckSize(int num_cards_left){
-    num_decks_left = static_cast<float>(num_cards_left) / 52.0f;
-
-    if (num_decks_left > 0) {
-        float raw = running_count / num_decks_left;
-        true_count = raw;
-    }
+    count.setCardsLeft(num_cards_left);
     return;
 }
 
 float RAPCStrategy::getTrueCount() const{
-    return true_count;
+    return count.trueCount();
 }
 
 float RAPCStrategy::getRunningCount() const{
-    return running_count;
+    return count.runningCount();
 }
 
 float RAPCStrategy::getDecksLeft() const{
-    return num_decks_left;
+    return count.decksLeft();
 }
 
 bool RAPCStrategy::shouldAcceptInsurance() const{
     const bool useSixDeck = initial_decks >= 5.5f;
     // 2-deck 65% pen: TC crossover = 8.0, 6-deck 80% pen: TC crossover = 11.0
     const float insuranceThreshold = useSixDeck ? 11.0f : 8.0f;
-    if (true_count >= insuranceThreshold){
+    if (count.trueCount() >= insuranceThreshold){
         return true;
     }
     return false;
@@ -292,10 +243,12 @@ Action RAPCStrategy::getSplitAction(Rank playerSplitRank, Rank dealerUpcard, flo
 }
 
 void RAPCStrategy::reset(int deckSize){
-    running_count = 0;
-    true_count = 0;
-    num_decks_left = deckSize;
-    initial_decks = deckSize;
+    count.reset(deckSize);
+    if (initial_decks != deckSize) {
+        // Indices are chosen by deck count
+        initial_decks = deckSize;
+        decisions.build(*this);
+    }
 }
 
 std::string RAPCStrategy::getName() {
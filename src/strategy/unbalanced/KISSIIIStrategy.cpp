@@ -1,10 +1,11 @@
 #include "KISSIIIStrategy.h"
+#include "CountTags.h"
 #include <cmath>
 
 KISSIIIStrategy::KISSIIIStrategy(float deck_size){
-    num_decks_left = deck_size;
-    true_count = deck_size * -2; //initial running count for KO system
+    count.reset(static_cast<int>(deck_size));
     deckStartSize = deck_size;
+    decisions.build(*this);
 }
 
 int KISSIIIStrategy::getEvenBet() const {
@@ -15,55 +16,41 @@ int KISSIIIStrategy::getBetSize() {
     return getEvenBet();
 }
 
-void KISSIIIStrategy::updateCount(Card card) {
-    Rank rank = card.getRank();
-    Suit suit = card.getSuit();
-    int score = static_cast<int>(rank) + INDEX_OFFSET;
-
-    constexpr int lowerCard = 7;
-    constexpr int upperCard = 10;
+void KISSIIIStrategy::setUnitSize(float kellyFraction) {
+    // Flat betting: unbalanced systems here only drive playing decisions
+    (void)kellyFraction;
+    return;
+}
 
-    if (rank == Rank::Two){ //red seven rule
-        if (suit == Suit::Spades || suit == Suit::Clubs){
-            true_count += 1;
-        }     
-    }
-    else if (score <= lowerCard){
-        true_count += 1;
-    }
-    else if (score >= upperCard){
-        true_count -= 1;
-    }
-    
+void KISSIIIStrategy::updateCount(Card card) {
+    count.add(card);
     return;
 }
 
 void KISSIIIStrategy::updateDeckSize(int num_cards_left){
-    num_decks_left = static_cast<float>(num_cards_left) / 52.0f;
-
-    if (num_decks_left > 0) {
-        float raw = true_count / num_decks_left;
-        true_count = raw;
-    }
-
+    count.setCardsLeft(num_cards_left);
     return;
 }
 
 float KISSIIIStrategy::getTrueCount() const{
-    return true_count;
+    return count.trueCount();
+}
+
+std::pair<float, float> KISSIIIStrategy::getTrueCountRange(int decks) const{
+    return count.countRange(decks);
 }
 
 float KISSIIIStrategy::getRunningCount() const{
-    return true_count;
+    return count.runningCount();
 }
 
 float KISSIIIStrategy::getDecksLeft() const{
-    return num_decks_left;
+    return count.decksLeft();
 }
 
 bool KISSIIIStrategy::shouldAcceptInsurance() const{
     constexpr int insuranceThreshold = 5; //mathmatical point where insurance is profitable accoding to gemini
-    if (true_count >= insuranceThreshold){
+    if (count.trueCount() >= insuranceThreshold){
         return true;
     }
     return false;
@@ -151,9 +138,8 @@ Action KISSIIIStrategy::shouldSurrender(int playerTotal, Rank dealerUpcard, floa
 }
 
 void KISSIIIStrategy::reset(int deckSize){
-    num_decks_left = deckSize;
+    count.reset(deckSize);
     deckStartSize = deckSize;
-    true_count = deckSize * -2;
 }
 
 std::string KISSIIIStrategy::getName() {
@@ -1,10 +1,11 @@
 #include "KoStrategy.h"
+#include "CountTags.h"
 #include <cmath>
 
 KoStrategy::KoStrategy(float deck_size){
-    num_decks_left = deck_size;
-    true_count = deck_size * -4; //initial running count for KO system
+    count.reset(static_cast<int>(deck_size));
     deckStartSize = deck_size;
+    decisions.build(*this);
 }
 
 int KoStrategy::getEvenBet() const {
@@ -15,49 +16,41 @@ int KoStrategy::getBetSize() {
     return getEvenBet();
 }
 
-void KoStrategy::updateCount(Card card) {
-    Rank rank = card.getRank();
-    int score = static_cast<int>(rank) + INDEX_OFFSET;
-
-    constexpr int lowerCard = 7;
-    constexpr int upperCard = 10;
+void KoStrategy::setUnitSize(float kellyFraction) {
+    // Flat betting: unbalanced systems here only drive playing decisions
+    (void)kellyFraction;
+    return;
+}
 
-    if (score <= lowerCard){
-        true_count += 1;
-    }
-    else if (score >= upperCard){
-        true_count -= 1;
-    }
-    
+void KoStrategy::updateCount(Card card) {
+    count.add(card);
     return;
 }
 
 void KoStrategy::updateDeckSize(int num_cards_left){
-    num_decks_left = static_cast<float>(num_cards_left) / 52.0f;
-
-    if (num_decks_left > 0) {
-        float raw = true_count / num_decks_left;
-        true_count = raw;
-    }
-    
+    count.setCardsLeft(num_cards_left);
     return;
 }
 
 float KoStrategy::getTrueCount() const{
-    return true_count;
+    return count.trueCount();
+}
+
+std::pair<float, float> KoStrategy::getTrueCountRange(int decks) const{
+    return count.countRange(decks);
 }
 
 float KoStrategy::getRunningCount() const{
-    return true_count;
+    return count.runningCount();
 }
 
 float KoStrategy::getDecksLeft() const{
-    return num_decks_left;
+    return count.decksLeft();
 }
 
 bool KoStrategy::shouldAcceptInsurance() const{
     constexpr int insuranceThreshold = 5; //mathmatical point where insurance is profitable accoding to gemini
-    if (true_count >= insuranceThreshold){
+    if (count.trueCount() >= insuranceThreshold){
         return true;
     }
     return false;
@@ -135,9 +128,8 @@ Action KoStrategy::shouldSurrender(int playerTotal, Rank dealerUpcard, float tru
 }
 
 void KoStrategy::reset(int deckSize){
-    num_decks_left = deckSize;
+    count.reset(deckSize);
     deckStartSize = deckSize;
-    true_count = deckSize * -4;
 }
 
 std::string KoStrategy::getName() {
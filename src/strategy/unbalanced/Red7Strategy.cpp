@@ -1,10 +1,11 @@
 #include "Red7Strategy.h"
+#include "CountTags.h"
 #include <cmath>
 
 Red7Strategy::Red7Strategy(float deck_size){
-    num_decks_left = deck_size;
-    true_count = deck_size * -2; //initial running count for KO system
+    count.reset(static_cast<int>(deck_size));
     deckStartSize = deck_size;
+    decisions.build(*this);
 }
 
 int Red7Strategy::getEvenBet() const {
@@ -15,54 +16,41 @@ int Red7Strategy::getBetSize() {
     return getEvenBet();
 }
 
-void Red7Strategy::updateCount(Card card) {
-    Rank rank = card.getRank();
-    Suit suit = card.getSuit();
-    int score = static_cast<int>(rank) + INDEX_OFFSET;
-
-    constexpr int lowerCard = 7;
-    constexpr int upperCard = 10;
+void Red7Strategy::setUnitSize(float kellyFraction) {
+    // Flat betting: unbalanced systems here only drive playing decisions
+    (void)kellyFraction;
+    return;
+}
 
-    if (rank == Rank::Seven){ //red seven rule
-        if (suit == Suit::Hearts || suit == Suit::Diamonds){
-            true_count += 1;
-        }     
-    }
-    else if (score <= lowerCard){
-        true_count += 1;
-    }
-    else if (score >= upperCard){
-        true_count -= 1;
-    }
-    
+void Red7Strategy::updateCount(Card card) {
+    count.add(card);
     return;
 }
 
 void Red7Strategy::updateDeckSize(int num_cards_left){
-    num_decks_left = static_cast<float>(num_cards_left) / 52.0f;
-
-    if (num_decks_left > 0) {
-        float raw = true_count / num_decks_left;
-        true_count = raw;
-    }
+    count.setCardsLeft(num_cards_left);
     return;
 }
 
 float Red7Strategy::getTrueCount() const{
-    return true_count;
+    return count.trueCount();
+}
+
+std::pair<float, float> Red7Strategy::getTrueCountRange(int decks) const{
+    return count.countRange(decks);
 }
 
 float Red7Strategy::getRunningCount() const{
-    return true_count;
+    return count.runningCount();
 }
 
 float Red7Strategy::getDecksLeft() const{
-    return num_decks_left;
+    return count.decksLeft();
 }
 
 bool Red7Strategy::shouldAcceptInsurance() const{
     constexpr int insuranceThreshold = 2; //mathmatical point where insurance is profitable accoding to gemini
-    if (true_count >= insuranceThreshold){
+    if (count.trueCount() >= insuranceThreshold){
         return true;
     }
     return false;
@@ -155,9 +143,8 @@ Action Red7Strategy::shouldSurrender(int playerTotal, Rank dealerUpcard, float t
 }
 
 void Red7Strategy::reset(int deckSize){
-    num_decks_left = deckSize;
+    count.reset(deckSize);
     deckStartSize = deckSize;
-    true_count = deckSize * -2;
 }
 
 std::string Red7Strategy::getName() {
@@ -1,10 +1,11 @@
 #include "UZenIIStrategy.h"
+#include "CountTags.h"
 #include <cmath>
 
 UZenIIStrategy::UZenIIStrategy(float deck_size){
-    num_decks_left = deck_size;
-    true_count = deck_size * -4; //initial running count for KO system
+    count.reset(static_cast<int>(deck_size));
     deckStartSize = deck_size;
+    decisions.build(*this);
 }
 
 int UZenIIStrategy::getEvenBet() const {
@@ -15,76 +16,41 @@ int UZenIIStrategy::getBetSize() {
     return getEvenBet();
 }
 
+void UZenIIStrategy::setUnitSize(float kellyFraction) {
+    // Flat betting: unbalanced systems here only drive playing decisions
+    (void)kellyFraction;
+    return;
+}
+
 void UZenIIStrategy::updateCount(Card card) {
-    Rank rank = card.getRank();
-    Suit suit = card.getSuit();
-    int score = static_cast<int>(rank) + INDEX_OFFSET;
-
-    switch (score)
-    {
-    case 2:
-        true_count += 1;
-        break;
-    case 3:
-        true_count += 2;
-        break;
-    case 4:
-        true_count += 2;
-        break;
-    case 5:
-        true_count += 2;
-        break;
-    case 6: 
-        true_count += 2;
-        break;
-    case 7:
-        true_count += 1;
-        break;
-    case 8:
-        true_count += 0;
-        break;
-    case 9:         
-        true_count += 0;
-        break;
-    case 10:
-        true_count -= 2;
-        break;
-    case 11: //Ace
-        true_count -= 1;
-        break;
-    
-    default:
-        break;
-    }
-    
+    count.add(card);
     return;
 }
 
 void UZenIIStrategy::updateDeckSize(int num_cards_left){
-    num_decks_left = static_cast<float>(num_cards_left) / 52.0f;
-
-    if (num_decks_left > 0) {
-        float raw = true_count / num_decks_left;
-        true_count = raw;
-    }
+    count.setCardsLeft(num_cards_left);
     return;
 }
 
 float UZenIIStrategy::getTrueCount() const{
-    return true_count;
+    return count.trueCount();
+}
+
+std::pair<float, float> UZenIIStrategy::getTrueCountRange(int decks) const{
+    return count.countRange(decks);
 }
 
 float UZenIIStrategy::getRunningCount() const{
-    return true_count;
+    return count.runningCount();
 }
 
 float UZenIIStrategy::getDecksLeft() const{
-    return num_decks_left;
+    return count.decksLeft();
 }
 
 bool UZenIIStrategy::shouldAcceptInsurance() const{
     constexpr int insuranceThreshold = 2; //mathmatical point where insurance is profitable accoding to gemini
-    if (true_count >= insuranceThreshold){
+    if (count.trueCount() >= insuranceThreshold){
         return true;
     }
     return false;
@@ -177,9 +143,8 @@ Action UZenIIStrategy::shouldSurrender(int playerTotal, Rank dealerUpcard, float
 }
 
 void UZenIIStrategy::reset(int deckSize){
-    num_decks_left = deckSize;
+    count.reset(deckSize);
     deckStartSize = deckSize;
-    true_count = deckSize * -4;
 }
 
 std::string UZenIIStrategy::getName() {
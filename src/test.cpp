@@ -5,8 +5,23 @@
 #include <cmath>
 #include <cstdint>
 #include <utility>
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
 
 #include "Engine.h"
+#include "ShoePipeline.h"
+#include "TreeReduce.h"
+#include "CountTags.h"
+#include "DealerKernel.h"
+#include "MultiCountTracker.h"
+#include "TaggedCount.h"
+#include "DeviationLoader.h"
+#include "KoStrategy.h"
 #include "HiLoStrategy.h"
 #include "NoStrategy.h"
 #include "BasicStrategy.h"
@@ -314,6 +329,60 @@ void testDealerBustChain() {
     std::cout << "PASSED" << std::endl;
 }
 
+// ----------------------------------------------------------------
+// TEST: Shoe runs out while the dealer draws; round is voided and refunded
+// ----------------------------------------------------------------
+void testShoeExhaustedMidRoundRefund() {
+    std::cout << "\n--- Running testShoeExhaustedMidRoundRefund ---" << std::endl;
+    
+    std::vector<Card> stack = {
+        Card(Rank::Two, Suit::Diamonds), // D Hit 1 (11), then the shoe is empty
+        Card(Rank::Ten, Suit::Clubs),    // P2
+        Card(Rank::Ten, Suit::Hearts),   // P1
+        Card(Rank::Four, Suit::Clubs),   // D Hole
+        Card(Rank::Five, Suit::Spades)   // D Up
+    };
+
+    Engine engine = setupEngine(stack);
+    auto result = engine.runner();
+
+    std::cout << "Final: " << result.first << " Total bet: " << result.second << std::endl;
+    assert(result.first == 1000);
+    assert(result.second == 0);
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: One engine replays several shoes, each from a fresh wallet
+// ----------------------------------------------------------------
+void testEngineReusedAcrossShoes() {
+    std::cout << "\n--- Running testEngineReusedAcrossShoes ---" << std::endl;
+    
+    std::vector<Card> stack = {
+        Card(Rank::Ten, Suit::Diamonds), // D Hit 3 (Bust)
+        Card(Rank::Five, Suit::Diamonds),// D Hit 2 (16)
+        Card(Rank::Two, Suit::Diamonds), // D Hit 1 (11)
+        Card(Rank::Ten, Suit::Clubs),    // P2
+        Card(Rank::Ten, Suit::Hearts),   // P1
+        Card(Rank::Four, Suit::Clubs),   // D Hole
+        Card(Rank::Five, Suit::Spades)   // D Up
+    };
+
+    Engine engine = setupEngine(stack);
+    auto first = engine.runner();
+
+    for (int shoe = 0; shoe < 3; ++shoe) {
+        engine.loadShoe(Deck::createTestDeck(stack));
+        auto again = engine.runner();
+        assert(again.first == first.first);
+        assert(again.second == first.second);
+    }
+
+    std::cout << "Final: " << first.first << std::endl;
+    assert(first.first == 1001);
+    std::cout << "PASSED" << std::endl;
+}
+
 // ----------------------------------------------------------------
 // TEST 5: Blackjack Push
 // ----------------------------------------------------------------
@@ -1307,6 +1376,364 @@ void testDeckSeedReproducibility() {
     std::cout << "PASSED" << std::endl;
 }
 
+// ----------------------------------------------------------------
+// TEST: Lazy shuffle deals a uniform permutation of the shoe
+// ----------------------------------------------------------------
+void testLazyShuffleDeck() {
+    std::cout << "\n--- Running testLazyShuffleDeck ---" << std::endl;
+
+    const std::uint64_t key = ShoeRng::deriveKey(7u, ShoeRng::hashTag("Lazy"));
+
+    // Every card of the shoe comes out exactly once, via deal() and hit()
+    Deck lazy(2, ShuffleMode::Lazy);
+    lazy.resetForShoe(key, 0);
+    std::map<std::pair<Rank, Suit>, int> seen;
+    std::vector<std::pair<Rank, Suit>> firstPass;
+    auto pair = lazy.deal();
+    seen[{pair.first.getRank(), pair.first.getSuit()}]++;
+    seen[{pair.second.getRank(), pair.second.getSuit()}]++;
+    firstPass.emplace_back(pair.first.getRank(), pair.first.getSuit());
+    while (lazy.getSize() > 0) {
+        Card c = lazy.hit();
+        seen[{c.getRank(), c.getSuit()}]++;
+        firstPass.emplace_back(c.getRank(), c.getSuit());
+    }
+    assert(seen.size() == 52);
+    for (const auto& entry : seen) {
+        assert(entry.second == 2);
+    }
+
+    // Same stream replays the same order; reset keeps the mode
+    lazy.resetForShoe(key, 0);
+    lazy.deal();
+    std::vector<std::pair<Rank, Suit>> secondPass;
+    while (lazy.getSize() > 0) {
+        Card c = lazy.hit();
+        secondPass.emplace_back(c.getRank(), c.getSuit());
+    }
+    assert(std::equal(secondPass.begin(), secondPass.end(), firstPass.begin() + 1));
+    assert(lazy.getShuffleMode() == ShuffleMode::Lazy);
+
+    // Aces land in the first two positions about 2 * 4/52 of the time
+    const int shoes = 20000;
+    int aces = 0;
+    for (int shoe = 0; shoe < shoes; ++shoe) {
+        lazy.resetForShoe(key, shoe + 1);
+        for (int i = 0; i < 2; ++i) {
+            if (lazy.hit().getRank() == Rank::Ace) {
+                aces++;
+            }
+        }
+    }
+    const double rate = static_cast<double>(aces) / (2 * shoes);
+    assert(std::abs(rate - 4.0 / 52.0) < 0.01);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: Rewinding to a mark replays the same cards
+// ----------------------------------------------------------------
+void testDeckMarkRewind() {
+    std::cout << "\n--- Running testDeckMarkRewind ---" << std::endl;
+
+    for (ShuffleMode mode : {ShuffleMode::Full, ShuffleMode::Lazy}) {
+        Deck deck(1, mode);
+        deck.resetForShoe(ShoeRng::deriveKey(11u, ShoeRng::hashTag("Rewind")), 0);
+        deck.deal();
+
+        const Deck::Mark start = deck.mark();
+        std::vector<std::pair<Rank, Suit>> first;
+        for (int i = 0; i < 5; ++i) {
+            Card c = deck.hit();
+            first.emplace_back(c.getRank(), c.getSuit());
+        }
+        deck.rewind(start);
+        assert(deck.getSize() == 50);
+
+        // A longer replay repeats the first five cards, then keeps dealing fresh ones
+        std::vector<std::pair<Rank, Suit>> second;
+        for (int i = 0; i < 8; ++i) {
+            Card c = deck.hit();
+            second.emplace_back(c.getRank(), c.getSuit());
+        }
+        assert(std::equal(first.begin(), first.end(), second.begin()));
+        deck.rewind(start);
+
+        std::vector<std::pair<Rank, Suit>> third;
+        for (int i = 0; i < 8; ++i) {
+            Card c = deck.hit();
+            third.emplace_back(c.getRank(), c.getSuit());
+        }
+        assert(third == second);
+    }
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: Background shuffle pipeline delivers the same shoes in order
+// ----------------------------------------------------------------
+void testShoePipelineOrder() {
+    std::cout << "\n--- Running testShoePipelineOrder ---" << std::endl;
+
+    auto drawShoe = [](Deck deck) {
+        std::vector<std::pair<Rank, Suit>> seq;
+        while (deck.getSize() > 0) {
+            Card c = deck.hit();
+            seq.emplace_back(c.getRank(), c.getSuit());
+        }
+        return seq;
+    };
+
+    const std::uint64_t key = ShoeRng::deriveKey(5u, ShoeRng::hashTag("Pipeline"));
+    const std::uint64_t shoeCount = 40;
+
+    // Pool smaller than the run so slots are recycled several times
+    ShoePipeline shoes(2, key, shoeCount, 10, 4);
+    for (std::uint64_t shoe = 0; shoe < shoeCount; ++shoe) {
+        const Deck& piped = shoes.next();
+        Deck expected(2);
+        expected.resetForShoe(key, 10 + shoe);
+        assert(drawShoe(piped) == drawShoe(expected));
+    }
+
+    // Destroying a pipeline that was not drained stops the producer
+    {
+        ShoePipeline partial(1, key, 1000, 0, 2);
+        partial.next();
+    }
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: Packed cards round-trip and count tag tables sum as expected
+// ----------------------------------------------------------------
+void testPackedCardTables() {
+    std::cout << "\n--- Running testPackedCardTables ---" << std::endl;
+
+    static_assert(Card(Rank::Ace, Suit::Hearts).getValue() == 11, "ace value");
+    static_assert(Card(Rank::Queen, Suit::Clubs).isWorthTen(), "queen is ten");
+    static_assert(CountTags::HI_LO[Card(Rank::Five, Suit::Spades).getCode()] == 1.0f, "hi-lo five");
+
+    auto deckSum = [](const CountTags::Table& tags) {
+        float sum = 0.0f;
+        for (int rank = 0; rank < Deck::NUM_RANK; ++rank) {
+            for (int suit = 0; suit < Deck::NUM_SUIT; ++suit) {
+                Card card(static_cast<Rank>(rank), static_cast<Suit>(suit));
+                assert(card.getRank() == static_cast<Rank>(rank));
+                assert(card.getSuit() == static_cast<Suit>(suit));
+                assert(card.getCode() < Card::CODE_COUNT);
+                sum += tags[card.getCode()];
+            }
+        }
+        return sum;
+    };
+
+    // Balanced systems sum to zero over a deck; unbalanced ones to their imbalance
+    for (const CountTags::Table* tags : {&CountTags::HI_LO, &CountTags::ZEN, &CountTags::MENTOR, &CountTags::OMEGA_II,
+                                         &CountTags::R14, &CountTags::RAPC, &CountTags::RPC, &CountTags::WONG_HALVES}) {
+        assert(deckSum(*tags) == 0.0f);
+    }
+    assert(deckSum(CountTags::KO) == 4.0f);
+    assert(deckSum(CountTags::RED_7) == 2.0f);
+    assert(deckSum(CountTags::KISS_III) == 2.0f);
+    assert(deckSum(CountTags::UZEN_II) == 4.0f);
+    assert(deckSum(CountTags::USTON_SS) == 4.0f);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: Hand keeps score, softness and pair state as cards come and go
+// ----------------------------------------------------------------
+void testHandIncrementalState() {
+    std::cout << "\n--- Running testHandIncrementalState ---" << std::endl;
+
+    Hand hand({Card(Rank::Ace, Suit::Spades), Card(Rank::Six, Suit::Hearts)}, 10);
+    assert(hand.getScore() == 17);
+    assert(hand.isHandSoft() && hand.isSoft17());
+    assert(!hand.checkCanSplit() && !hand.isBlackjack());
+
+    hand.addCard(Card(Rank::Ace, Suit::Clubs));   // A A 6 = soft 18
+    assert(hand.getScore() == 18 && hand.isHandSoft());
+    hand.addCard(Card(Rank::King, Suit::Clubs));  // hard 18
+    assert(hand.getScore() == 18 && !hand.isHandSoft());
+    hand.addCard(Card(Rank::Five, Suit::Clubs));  // hard 23
+    assert(hand.checkOver() && hand.getFinalScore() == 0);
+
+    hand.popLastCard();
+    hand.popLastCard();
+    assert(hand.getScore() == 18 && hand.isHandSoft());
+    assert(hand.getCards().size() == 3);
+    assert(hand.getLastCard().getRank() == Rank::Ace);
+
+    Hand pair({Card(Rank::Eight, Suit::Spades), Card(Rank::Eight, Suit::Hearts)}, 10);
+    assert(pair.checkCanSplit());
+    Hand split(pair.getLastCard(), pair.getBetSize());
+    pair.popLastCard();
+    assert(pair.getScore() == 8 && split.getScore() == 8);
+
+    Hand natural({Card(Rank::Queen, Suit::Spades), Card(Rank::Ace, Suit::Hearts)}, 10);
+    assert(natural.isBlackjack() && natural.getScore() == 21);
+    Hand aces({Card(Rank::Ace, Suit::Spades), Card(Rank::Ace, Suit::Hearts)}, 10);
+    assert(aces.isAces() && aces.getScore() == 12 && !aces.isBlackjack());
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: Dealer kernel matches the hand-scoring dealer loop
+// ----------------------------------------------------------------
+void testDealerKernelMatchesHandRules() {
+    std::cout << "\n--- Running testDealerKernelMatchesHandRules ---" << std::endl;
+
+    Hand soft17({Card(Rank::Ace, Suit::Spades), Card(Rank::Six, Suit::Hearts)}, 0);
+    assert(!DealerKernel::stops<true>(DealerKernel::stateOf(soft17)));
+    assert(DealerKernel::stops<false>(DealerKernel::stateOf(soft17)));
+
+    Deck deck(6);
+    deck.resetForShoe(ShoeRng::deriveKey(9u, ShoeRng::hashTag("Dealer")), 0);
+    for (int round = 0; round < 2000; ++round) {
+        if (deck.getSize() < 20) {
+            deck.reset();
+        }
+        const Deck::Mark start = deck.mark();
+        for (bool hitSoft17 : {true, false}) {
+            Hand expected(deck.deal(), 0);
+            while (!expected.isDealerOver() || (expected.isSoft17() && hitSoft17)) {
+                expected.addCard(deck.hit());
+            }
+            deck.rewind(start);
+
+            Hand dealer(deck.deal(), 0);
+            int drawn = 0;
+            DealerKernel::play(dealer, hitSoft17, [&deck]() { return deck.tryHit(); }, [&drawn](Card) { drawn++; });
+            assert(dealer.getScore() == expected.getScore());
+            assert(dealer.getCards().size() == expected.getCards().size());
+            assert(drawn == static_cast<int>(dealer.getCards().size()) - 2);
+            deck.rewind(start);
+        }
+        // Move on to a fresh starting hand
+        deck.deal();
+    }
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: Deck tracks remaining composition through draws and rewinds
+// ----------------------------------------------------------------
+void testDeckComposition() {
+    std::cout << "\n--- Running testDeckComposition ---" << std::endl;
+
+    Deck shoe(6, ShuffleMode::Lazy);
+    shoe.resetForShoe(ShoeRng::deriveKey(3u, ShoeRng::hashTag("DeckComposition")), 0);
+    assert(shoe.getSize() == 312);
+    assert(shoe.remainingOfRank(Rank::Ace) == 24);
+    assert(shoe.remainingTens() == 96);
+    assert(std::abs(shoe.tenDensity() - 96.0 / 312.0) < 1e-12);
+
+    // A rewound rollout gives its cards back to the counts
+    const Deck::Mark start = shoe.mark();
+    std::optional<std::pair<Card, Card>> rollout = shoe.tryDeal();
+    assert(rollout && shoe.tryHit());
+    shoe.rewind(start);
+    assert(shoe.remainingOfRank(Rank::Ace) == 24 && shoe.remainingTens() == 96);
+
+    int acesDealt = 0;
+    int tensDealt = 0;
+    auto tally = [&](Card c) {
+        acesDealt += c.isAce() ? 1 : 0;
+        tensDealt += c.isWorthTen() ? 1 : 0;
+        assert(shoe.remainingOfRank(Rank::Ace) == 24 - acesDealt);
+        assert(shoe.remainingTens() == 96 - tensDealt);
+    };
+    while (shoe.getSize() >= 2) {
+        const std::pair<Card, Card> cards = *shoe.tryDeal();
+        acesDealt += cards.first.isAce() ? 1 : 0;
+        tensDealt += cards.first.isWorthTen() ? 1 : 0;
+        tally(cards.second);
+        if (std::optional<Card> card = shoe.tryHit()) {
+            tally(*card);
+        }
+    }
+    assert(acesDealt == 24 && tensDealt == 96);
+    assert(shoe.tenDensity() == 0.0);
+
+    shoe.reset();
+    assert(shoe.getSize() == 312);
+    assert(shoe.remainingOfRank(Rank::King) == 24);
+
+    Deck rigged = Deck::createTestDeck({Card(Rank::Ace, Suit::Spades), Card(Rank::King, Suit::Hearts), Card(Rank::Five, Suit::Clubs)});
+    assert(rigged.remainingOfRank(Rank::Ace) == 1 && rigged.remainingTens() == 1);
+    rigged.hit();
+    assert(rigged.remainingOfRank(Rank::Five) == 0 && rigged.remainingTens() == 1);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: Per-shoe RNG streams regenerate any shoe directly
+// ----------------------------------------------------------------
+void testShoeStreamReproducibility() {
+    std::cout << "\n--- Running testShoeStreamReproducibility ---" << std::endl;
+
+    auto drawShoe = [](Deck& deck) {
+        std::vector<std::pair<Rank, Suit>> seq;
+        while (deck.getSize() > 0) {
+            Card c = deck.hit();
+            seq.emplace_back(c.getRank(), c.getSuit());
+        }
+        return seq;
+    };
+
+    const std::uint64_t key = ShoeRng::deriveKey(42u, ShoeRng::hashTag("HiLoStrategy"));
+
+    // Shoe 7 dealt after shoes 0..6 matches shoe 7 dealt on its own
+    Deck sequential(2);
+    for (std::uint64_t shoe = 0; shoe < 7; ++shoe) {
+        sequential.resetForShoe(key, shoe);
+        drawShoe(sequential);
+    }
+    sequential.resetForShoe(key, 7);
+    const auto seqA = drawShoe(sequential);
+
+    Deck direct(2);
+    direct.resetForShoe(key, 7);
+    const auto seqB = drawShoe(direct);
+
+    Deck other(2);
+    other.resetForShoe(key, 8);
+    const auto seqC = drawShoe(other);
+
+    assert(seqA.size() == 104);
+    assert(seqA == seqB);
+    assert(seqA != seqC);
+
+    // Seeking is O(1) and lands on the same output as stepping
+    ShoeRng stepped(key, 3);
+    for (int i = 0; i < 11; ++i) {
+        stepped();
+    }
+    ShoeRng seeked(key);
+    seeked.seek(3, 11);
+    assert(stepped() == seeked());
+
+    // Batched bounded draws stay in range
+    ShoeRng bounded(key);
+    for (std::uint32_t range = 1; range < 500; ++range) {
+        std::uint32_t a;
+        std::uint32_t b;
+        bounded.bounded2(range + 1, range, a, b);
+        assert(a <= range && b < range);
+        assert(bounded.bounded(range) < range);
+    }
+
+    std::cout << "PASSED" << std::endl;
+}
+
 // ----------------------------------------------------------------
 // TEST: Rigged three-hand shoe, no hits, verify final running/true count
 // Each hand: dealer up Ten (-1), dealer hole Seven (0), player 10 (-1), player 10 (-1)
@@ -1639,6 +2066,685 @@ void testRiggedSplitHandPositiveCount() {
     std::cout << "PASSED" << std::endl;
 }
 
+void testStaticRulesMatchRuntimeRules() {
+    std::cout << "\n--- Running testStaticRulesMatchRuntimeRules ---" << std::endl;
+
+    // Monte Carlo with nothing to evaluate falls back to the runtime-rules loop,
+    // so it must play the same shoe identically to the compiled specialisation.
+    Deck::setSeed(4242u);
+    for (int rules = 0; rules < 8; ++rules) {
+        Deck shoe(6);
+        std::pair<double, double> results[2];
+        for (int monteCarlo = 0; monteCarlo < 2; ++monteCarlo) {
+            BotPlayer player(false, std::make_unique<NoStrategy>(6));
+            Engine engine = EngineBuilder()
+                    .setDeckSize(6)
+                    .setDeck(shoe)
+                    .setPenetrationThreshold(.75)
+                    .setInitialWallet(1000)
+                    .with3To2Payout(true)
+                    .withH17Rules((rules & 4) != 0)
+                    .allowDoubleAfterSplit((rules & 2) != 0)
+                    .allowReSplitAces((rules & 1) != 0)
+                    .enableMontiCarlo(monteCarlo == 1)
+                    .build(&player);
+            results[monteCarlo] = engine.runner();
+        }
+        assert(results[0].first == results[1].first);
+        assert(results[0].second == results[1].second);
+    }
+    Deck::clearSeed();
+    std::cout << "PASSED" << std::endl;
+}
+
+void testTypedStrategyMatchesDynamicPath() {
+    std::cout << "\n--- Running testTypedStrategyMatchesDynamicPath ---" << std::endl;
+
+    // A bare HiLo bot takes the devirtualised path; wrapping it in the logging
+    // decorator forces the virtual one. Both must play the shoe identically.
+    EventBus& bus = EventBus::getInstance();
+    bus.detachAll();
+    Deck::setSeed(777u);
+    Deck shoe(6);
+
+    BotPlayer typed(false, std::make_unique<HiLoStrategy>(6));
+    BotPlayer dynamic(false, std::make_unique<LoggingCountingStrategy>(std::make_unique<HiLoStrategy>(6), bus));
+
+    std::pair<double, double> results[2];
+    BotPlayer* players[2] = {&typed, &dynamic};
+    for (int i = 0; i < 2; ++i) {
+        Engine engine = EngineBuilder()
+                .setDeckSize(6)
+                .setDeck(shoe)
+                .setPenetrationThreshold(.75)
+                .setInitialWallet(1000)
+                .with3To2Payout(true)
+                .withH17Rules(true)
+                .allowDoubleAfterSplit(true)
+                .build(players[i]);
+        results[i] = engine.runner();
+    }
+    Deck::clearSeed();
+
+    assert(results[0].first == results[1].first);
+    assert(results[0].second == results[1].second);
+    assert(typed.getTrueCount() == dynamic.getTrueCount());
+    std::cout << "PASSED" << std::endl;
+}
+
+void testNullTraceMatchesEventTrace() {
+    std::cout << "\n--- Running testNullTraceMatchesEventTrace ---" << std::endl;
+
+    // Events off selects the NullTrace loop: same play, nothing published.
+    EventBus& bus = EventBus::getInstance();
+    bus.detachAll();
+    CountStatsObserver observer;
+    bus.registerObserver(&observer, EventType::GameStats);
+
+    Deck::setSeed(99u);
+    Deck shoe(2);
+    std::pair<double, double> results[2];
+    int statsSeen[2];
+    for (int traced = 0; traced < 2; ++traced) {
+        observer.statsEventsSeen = 0;
+        BotPlayer player(false, std::make_unique<HiLoStrategy>(2));
+        Engine engine = EngineBuilder()
+                .withEventBus(&bus)
+                .setDeckSize(2)
+                .setDeck(shoe)
+                .setPenetrationThreshold(.75)
+                .setInitialWallet(1000)
+                .enableEvents(traced == 1)
+                .with3To2Payout(true)
+                .withH17Rules(true)
+                .allowDoubleAfterSplit(true)
+                .build(&player);
+        results[traced] = engine.runner();
+        statsSeen[traced] = observer.statsEventsSeen;
+    }
+    Deck::clearSeed();
+    bus.detachAll();
+
+    assert(results[0].first == results[1].first);
+    assert(results[0].second == results[1].second);
+    assert(statsSeen[0] == 0);
+    assert(statsSeen[1] > 0);
+    std::cout << "PASSED" << std::endl;
+}
+
+void testTwoSeatTableDealOrderAndCount() {
+    std::cout << "\n--- Running testTwoSeatTableDealOrderAndCount ---" << std::endl;
+
+    // Dealt from the back: seat cards, dealer up card, seat cards, hole card.
+    std::vector<Card> stack = {
+        Card(Rank::Seven, Suit::Hearts),  // D Hole (17)
+        Card(Rank::Eight, Suit::Clubs),   // S2 second (18)
+        Card(Rank::Nine, Suit::Clubs),    // S1 second (19)
+        Card(Rank::Ten, Suit::Spades),    // D Up
+        Card(Rank::Ten, Suit::Hearts),    // S2 first
+        Card(Rank::Ten, Suit::Diamonds)   // S1 first
+    };
+
+    EventBus::getInstance().detachAll();
+    BotPlayer first(false, std::make_unique<HiLoStrategy>(1));
+    BotPlayer second(false, std::make_unique<HiLoStrategy>(1));
+    Engine engine = EngineBuilder()
+            .setDeckSize(0)
+            .setDeck(Deck::createTestDeck(stack))
+            .setPenetrationThreshold(.5)
+            .setInitialWallet(1000)
+            .with3To2Payout(true)
+            .withH17Rules(true)
+            .build(std::vector<Player*>{&first, &second});
+    engine.runner();
+
+    // Both seats stand and beat the dealer's 17
+    std::vector<std::pair<double, double>> results = engine.getSeatResults();
+    assert(results.size() == 2);
+    for (const auto& result : results) {
+        assert(result.second > 0);
+        assert(result.first == 1000 + result.second);
+    }
+
+    // Each seat counted all six exposed cards exactly once: three tens, no low cards
+    assert(first.getStrategy()->getRunningCount() == -3);
+    assert(second.getStrategy()->getRunningCount() == -3);
+    std::cout << "PASSED" << std::endl;
+}
+
+void testMultiCountTrackerLanesMatchStrategies() {
+    std::cout << "\n--- Running testMultiCountTrackerLanesMatchStrategies ---" << std::endl;
+
+    // Balanced lanes against the strategies themselves, in lane order
+    std::vector<std::unique_ptr<CountingStrategy>> systems;
+    systems.push_back(std::make_unique<HiLoStrategy>(2));
+    systems.push_back(std::make_unique<ZenCountStrategy>(2));
+    systems.push_back(std::make_unique<MentorStrategy>(2));
+    systems.push_back(std::make_unique<OmegaIIStrategy>(2));
+    systems.push_back(std::make_unique<R14Strategy>(2));
+    systems.push_back(std::make_unique<RAPCStrategy>(2));
+    systems.push_back(std::make_unique<RPCStrategy>(2));
+    systems.push_back(std::make_unique<WongHalvesStrategy>(2));
+    assert(systems.size() == MultiCountTracker::BALANCED_LANES);
+
+    // Unbalanced lanes against their tag tables and initial running counts
+    const CountTags::Table* unbalancedTags[] = {&CountTags::KO, &CountTags::UZEN_II, &CountTags::USTON_SS, &CountTags::RED_7, &CountTags::KISS_III};
+    float unbalancedCounts[] = {-8, -8, -8, -4, -4};
+
+    MultiCountTracker tracker(2);
+    Deck::setSeed(31u);
+    Deck deck(2);
+    Deck::clearSeed();
+    for (int i = 0; i < 70; ++i) {
+        Card card = deck.hit();
+        tracker.updateCount(card);
+        for (auto& system : systems) {
+            system->updateCount(card);
+        }
+        for (int u = 0; u < 5; ++u) {
+            unbalancedCounts[u] += (*unbalancedTags[u])[card.getCode()];
+        }
+    }
+
+    for (int lane = 0; lane < MultiCountTracker::BALANCED_LANES; ++lane) {
+        assert(MultiCountTracker::isBalanced(lane));
+        assert(MultiCountTracker::laneName(lane) == systems[lane]->getName());
+        assert(std::fabs(tracker.getLaneRunningCount(lane) - systems[lane]->getRunningCount()) < 1e-4f);
+    }
+    for (int u = 0; u < 5; ++u) {
+        const int lane = MultiCountTracker::BALANCED_LANES + u;
+        assert(!MultiCountTracker::isBalanced(lane));
+        assert(tracker.getLaneRunningCount(lane) == unbalancedCounts[u]);
+    }
+    assert(MultiCountTracker::laneName(MultiCountTracker::BALANCED_LANES) == "KoStrategy");
+
+    // One hand's result lands in exactly one bucket per lane
+    tracker.updateDeckSize(deck.getSize());
+    tracker.beginHand();
+    tracker.recordResult(-1.0, 1.0);
+    for (int lane = 0; lane < MultiCountTracker::LANES; ++lane) {
+        const TrueCountHistogram& table = tracker.getLaneEVperTC(lane);
+        const int bin = table.binIndex(tracker.getLaneCount(lane));
+        assert(table.occupiedBins() == 1);
+        assert(table.bin(bin).handsPlayed == 1);
+        assert(table.binTrueCount(bin) == std::round(tracker.getLaneCount(lane) * 2.0f) / 2.0f);
+    }
+    assert(tracker.getLaneCount(0) == tracker.getTrueCount());
+
+    // Through the engine every lane sees every settled wager
+    BotPlayer robot(false, std::make_unique<MultiCountTracker>(2));
+    const auto& engineTracker = static_cast<const MultiCountTracker&>(*robot.getStrategy());
+    TrueCountHistogram EVperTC;
+    Engine engine = EngineBuilder()
+            .setDeckSize(2)
+            .setDeck(Deck(2))
+            .setPenetrationThreshold(.75)
+            .setInitialWallet(1000)
+            .setEVperTC(EVperTC)
+            .build(&robot);
+    engine.runShoes(20);
+    auto handsIn = [](const TrueCountHistogram& table) {
+        int hands = 0;
+        for (int bin = 0; bin < table.binCount(); ++bin) {
+            hands += table.bin(bin).handsPlayed;
+        }
+        return hands;
+    };
+    assert(handsIn(EVperTC) > 0);
+    for (int lane = 0; lane < MultiCountTracker::LANES; ++lane) {
+        assert(handsIn(engineTracker.getLaneEVperTC(lane)) == handsIn(EVperTC));
+    }
+    assert(engineTracker.getLaneEVperTC(0).occupiedBins() == EVperTC.occupiedBins());
+
+    // Unbalanced tables are sized from the IRC: 8-deck KO starts at -32
+    const auto koRange = MultiCountTracker::unbalancedCountRange(MultiCountTracker::BALANCED_LANES, 8);
+    assert(koRange.first == -32.0f - 20 * 8 && koRange.second == -32.0f + 24 * 8);
+    BotPlayer eightDeckRobot(false, std::make_unique<MultiCountTracker>(8));
+    const auto& eightDeckTracker = static_cast<const MultiCountTracker&>(*eightDeckRobot.getStrategy());
+    Engine eightDeck = EngineBuilder()
+            .setDeckSize(8)
+            .setDeck(Deck(8))
+            .setPenetrationThreshold(.80)
+            .setInitialWallet(1000)
+            .build(&eightDeckRobot);
+    eightDeck.runShoes(10);
+    for (int lane = MultiCountTracker::BALANCED_LANES; lane < MultiCountTracker::LANES; ++lane) {
+        const TrueCountHistogram& table = eightDeckTracker.getLaneEVperTC(lane);
+        assert(handsIn(table) > 0);
+        assert(table.bin(0).handsPlayed == 0 && table.bin(table.binCount() - 1).handsPlayed == 0);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void testTaggedCountMatchesTagTables() {
+    std::cout << "\n--- Running testTaggedCountMatchesTagTables ---" << std::endl;
+
+    static_assert(TaggedCount<CountTags::HI_LO, true>::SCALE == 1);
+    static_assert(TaggedCount<CountTags::WONG_HALVES, true>::SCALE == 2);
+
+    TaggedCount<CountTags::WONG_HALVES, true> halves(6);
+    TaggedCount<CountTags::OMEGA_II, true> omega(6);
+    TaggedCount<CountTags::KO, false, -4> ko(6);
+    assert(ko.runningCount() == -24.0f);
+
+    double halvesSum = 0, omegaSum = 0;
+    Deck::setSeed(47u);
+    Deck deck(6);
+    Deck::clearSeed();
+    for (int i = 0; i < 200; ++i) {
+        Card card = deck.hit();
+        halves.add(card);
+        omega.add(card);
+        ko.add(card);
+        halvesSum += CountTags::WONG_HALVES[card.getCode()];
+        omegaSum += CountTags::OMEGA_II[card.getCode()];
+    }
+    halves.setCardsLeft(deck.getSize());
+    omega.setCardsLeft(deck.getSize());
+    // Halves tags are multiples of 0.5, so the scaled integer count is exact
+    assert(halves.runningCount() == static_cast<float>(halvesSum));
+    assert(omega.runningCount() == static_cast<float>(omegaSum));
+    const float decksLeft = deck.getSize() / 52.0f;
+    assert(std::fabs(halves.trueCount() - static_cast<float>(halvesSum) / decksLeft) < 1e-4f);
+    assert(std::fabs(omega.decksLeft() - decksLeft) < 1e-6f);
+
+    // Unbalanced strategies report the running count, however often depth is updated
+    KoStrategy koStrategy(6);
+    koStrategy.updateCount(Card(Rank::Two, Suit::Hearts));
+    koStrategy.updateCount(Card(Rank::Five, Suit::Clubs));
+    assert(koStrategy.getTrueCount() == -22.0f);
+    koStrategy.updateDeckSize(150);
+    koStrategy.updateDeckSize(100);
+    assert(koStrategy.getTrueCount() == -22.0f);
+    assert(koStrategy.getRunningCount() == -22.0f);
+    koStrategy.reset(2);
+    assert(koStrategy.getRunningCount() == -8.0f);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testDecisionTableMatchesStrategies() {
+    std::cout << "\n--- Running testDecisionTableMatchesStrategies ---" << std::endl;
+
+    std::vector<std::unique_ptr<CountingStrategy>> systems;
+    for (int decks : {2, 6}) {
+        systems.push_back(std::make_unique<NoStrategy>(decks));
+        systems.push_back(std::make_unique<HiLoStrategy>(decks));
+        systems.push_back(std::make_unique<ZenCountStrategy>(decks));
+        systems.push_back(std::make_unique<MentorStrategy>(decks));
+        systems.push_back(std::make_unique<OmegaIIStrategy>(decks));
+        systems.push_back(std::make_unique<R14Strategy>(decks));
+        systems.push_back(std::make_unique<RAPCStrategy>(decks));
+        systems.push_back(std::make_unique<RPCStrategy>(decks));
+        systems.push_back(std::make_unique<WongHalvesStrategy>(decks));
+        systems.push_back(std::make_unique<KoStrategy>(decks));
+        systems.push_back(std::make_unique<UZenIIStrategy>(decks));
+        systems.push_back(std::make_unique<UstonSSStrategy>(decks));
+        systems.push_back(std::make_unique<Red7Strategy>(decks));
+        systems.push_back(std::make_unique<KISSIIIStrategy>(decks));
+        systems.push_back(std::make_unique<MultiCountTracker>(decks));
+    }
+    // Reset to another deck count recompiles the deck-dependent indices
+    systems.push_back(std::make_unique<HiLoStrategy>(2));
+    systems.back()->reset(6);
+
+    std::vector<float> counts = {0.0f, -0.0f, 1e-6f, -1e-6f, -40.0f, 40.0f};
+    for (float tc = -30.0f; tc <= 30.0f; tc += 0.25f) {
+        counts.push_back(tc);
+        counts.push_back(std::nextafter(tc, -100.0f));
+    }
+
+    for (auto& system : systems) {
+        const DecisionTable& table = system->getDecisionTable();
+        for (int up = 0; up < DecisionTable::UPCARDS; ++up) {
+            const Rank upcard = static_cast<Rank>(up);
+            for (float tc : counts) {
+                for (int total = 4; total <= 21; ++total) {
+                    assert(table.lookup(DecisionTable::Hard, total, upcard, tc) == system->getHardHandAction(total, upcard, tc));
+                    assert(table.lookup(DecisionTable::Surrender, total, upcard, tc) == system->shouldSurrender(total, upcard, tc));
+                }
+                for (int total = 13; total <= 21; ++total) {
+                    assert(table.lookup(DecisionTable::Soft, total, upcard, tc) == system->getSoftHandAction(total, upcard));
+                }
+                for (int pair = 0; pair < DecisionTable::UPCARDS; ++pair) {
+                    const Rank pairRank = static_cast<Rank>(pair);
+                    assert(table.lookup(DecisionTable::Pair, pair, upcard, tc) == system->getSplitAction(pairRank, upcard, tc));
+                }
+            }
+        }
+    }
+
+    // Strict and inclusive indices land on the exact flip point
+    KoStrategy ko(2);
+    const DecisionTable::Entry& strict = ko.getDecisionTable().entry(DecisionTable::Hard, 16, Rank::Ten);
+    assert(strict.basic == Action::Hit && strict.deviation == Action::Stand);
+    assert(strict.index > 0.0f && strict.index == std::nextafter(0.0f, 1.0f));
+    HiLoStrategy hilo(6);
+    const DecisionTable::Entry& inclusive = hilo.getDecisionTable().entry(DecisionTable::Hard, 15, Rank::King);
+    assert(inclusive.index == 3.5f && inclusive.deviation == Action::Stand);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// ----------------------------------------------------------------
+// TEST: The engine's EV-per-TC table spans an unbalanced running count
+// ----------------------------------------------------------------
+void testEngineEVperTCSpansUnbalancedCount() {
+    std::cout << "\n--- Running testEngineEVperTCSpansUnbalancedCount ---" << std::endl;
+
+    // 8-deck KO starts at -32, outside the +/-30 a balanced count gets
+    assert(KoStrategy(8).getTrueCountRange(8) == std::make_pair(-192.0f, 160.0f));
+    assert(HiLoStrategy(8).getTrueCountRange(8) == std::make_pair(TrueCountHistogram::DEFAULT_MIN, TrueCountHistogram::DEFAULT_MAX));
+
+    BotPlayer robot(false, std::make_unique<KoStrategy>(8));
+    Engine engine = EngineBuilder()
+            .setDeckSize(8)
+            .setDeck(Deck(8))
+            .setPenetrationThreshold(.80)
+            .setInitialWallet(1000)
+            .build(&robot);
+    engine.runShoes(10);
+    const TrueCountHistogram& table = engine.getSeatEVperTC(0);
+    assert(table.getMinTrueCount() == -192.0f && table.getMaxTrueCount() == 160.0f);
+    int hands = 0;
+    for (int bin = 0; bin < table.binCount(); ++bin) {
+        hands += table.bin(bin).handsPlayed;
+    }
+    assert(hands > 0);
+    assert(table.bin(0).handsPlayed == 0 && table.bin(table.binCount() - 1).handsPlayed == 0);
+    assert(table.bin(table.binIndex(-32.0f)).handsPlayed > 0);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testDeviationLoaderAppliesReportIndices() {
+    std::cout << "\n--- Running testDeviationLoaderAppliesReportIndices ---" << std::endl;
+
+    DeviationLoader reports;
+    assert(reports.loadDirectory("data/deviation_data") == 2);
+    assert(DeviationLoader::gameKey(2, 0.65f) == "2deck_65pen");
+    assert(reports.find("HiLoStrategy", true, 2, 0.80f) == nullptr);
+
+    const DeviationSet* hiloH17 = reports.find("HiLoStrategy", true, 2, 0.65f);
+    assert(hiloH17 != nullptr);
+    assert(hiloH17->getIndex(DecisionTable::Hard, 16, Rank::Queen) == 0.5f);
+    assert(hiloH17->getIndex(DecisionTable::Pair, static_cast<int>(Rank::Jack), Rank::Five) == 4.5f);
+    assert(hiloH17->getIndex(DecisionTable::Surrender, 16, Rank::Ace) == -2.0f);
+    assert(hiloH17->insuranceIndex == 2.5f);
+    // N/A crossovers are left to the strategy
+    const DeviationSet* noneH17 = reports.find("NoStrategy", true, 2, 0.65f);
+    assert(noneH17 != nullptr && std::isnan(noneH17->getIndex(DecisionTable::Hard, 9, Rank::Two)));
+
+    // Report cells replace the built-in ones, including the side below the index:
+    // the built-in table stands on 13v2 at any count, the report hits below -0.5
+    HiLoStrategy hilo(2);
+    hilo.useDeviations(reports.find("HiLoStrategy", false, 2, 0.65f));
+    const DecisionTable& table = hilo.getDecisionTable();
+    assert(table.lookup(DecisionTable::Pair, static_cast<int>(Rank::Ten), Rank::Five, 4.0f) == Action::Split);
+    assert(table.lookup(DecisionTable::Pair, static_cast<int>(Rank::Ten), Rank::Five, 3.5f) == Action::Stand);
+    assert(table.lookup(DecisionTable::Hard, 13, Rank::Two, -1.0f) == Action::Hit);
+    assert(table.lookup(DecisionTable::Hard, 13, Rank::Two, -0.5f) == Action::Stand);
+    assert(table.lookup(DecisionTable::Surrender, 15, Rank::Ten, -0.5f) == Action::Surrender);
+
+    // Overrides survive a rebuild and come off again with nullptr
+    hilo.reset(6);
+    assert(table.lookup(DecisionTable::Hard, 13, Rank::Two, -1.0f) == Action::Hit);
+    hilo.useDeviations(nullptr);
+    assert(table.lookup(DecisionTable::Hard, 13, Rank::Two, -1.0f) == Action::Stand);
+
+    // Insurance follows the loaded index through the player: 2-deck HiLo
+    // insures from 2.5 built in, the 6-deck report from 3.0
+    auto owned = std::make_unique<HiLoStrategy>(2);
+    owned->useDeviations(reports.find("HiLoStrategy", true, 6, 0.80f));
+    for (int i = 0; i < 5; ++i) {
+        owned->updateCount(Card(Rank::Five, Suit::Spades));
+    }
+    owned->updateDeckSize(104);
+    assert(owned->getTrueCount() == 2.5f && owned->shouldAcceptInsurance());
+    BotPlayer insurer(false, std::move(owned));
+    assert(!insurer.shouldAcceptInsurance());
+
+    // A report whose Action A/Action B are swapped, or whose numbers do not
+    // parse, is rejected with the file and row instead of loading inverted
+    auto rejects = [](const std::string& row) {
+        const std::string path = (std::filesystem::temp_directory_path() / "deviation_report_bad.csv").string();
+        {
+            std::ofstream report(path);
+            report << "Game Config,Strategy,Rules,Decision,Action A,Action B,Player Value,Dealer Upcard,Deviation TC,Total Hands,Notes\n"
+                   << row << "\n";
+        }
+        std::string message;
+        try {
+            DeviationLoader().loadReport(path);
+        } catch (const std::runtime_error& e) {
+            message = e.what();
+        }
+        std::filesystem::remove(path);
+        return message.find(path + " row 2") != std::string::npos;
+    };
+    assert(!rejects("2deck_65pen,HiLoStrategy,H17,Hit_vs_Stand,Hit,Stand,16,10,0.5,100,"));
+    assert(rejects("2deck_65pen,HiLoStrategy,H17,Hit_vs_Stand,Stand,Hit,16,10,0.5,100,"));
+    assert(rejects("2deck_65pen,HiLoStrategy,H17,Hit_vs_Stand,Hit,Stand,sixteen,10,0.5,100,"));
+    assert(rejects("2deck_65pen,HiLoStrategy,H17,Hit_vs_Stand,Hit,Stand,16,10,0.5x,100,"));
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testBetRampIsPerEngine() {
+    std::cout << "\n--- Running testBetRampIsPerEngine ---" << std::endl;
+
+    // Counts bet the nearest half TC, the engine's EV-per-TC bucket
+    HiLoStrategy bucketed(2);
+    for (int i = 0; i < 3; ++i) {
+        bucketed.updateCount(Card(Rank::Five, Suit::Hearts));
+    }
+    bucketed.updateDeckSize(54); // TC 2.89
+    const int nearTC3 = bucketed.getBetSize();
+    bucketed.updateDeckSize(52); // TC 3
+    assert(bucketed.getBetSize() == nearTC3);
+    bucketed.updateDeckSize(60); // TC 2.6
+    const int nearTC25 = bucketed.getBetSize();
+    bucketed.updateDeckSize(65); // TC 2.4
+    assert(bucketed.getBetSize() == nearTC25);
+
+    // Each engine sizes its own strategy from its own wallet
+    auto runTable = [](double wallet, std::pair<double, double>* result, float* unit) {
+        BotPlayer robot(false, std::make_unique<HiLoStrategy>(2));
+        Engine engine = EngineBuilder()
+                .setDeckSize(2)
+                .setDeck(Deck(2))
+                .setPenetrationThreshold(.75)
+                .setInitialWallet(wallet)
+                .setKellyRisk(0.5f)
+                .build(&robot);
+        *result = engine.runShoes(30);
+        *unit = robot.getStrategy()->getUnitSize();
+    };
+    std::pair<double, double> smallAlone, largeAlone, smallShared, largeShared;
+    float smallUnit = 0, largeUnit = 0, unused = 0;
+    Deck::setSeed(77u);
+    runTable(1000, &smallAlone, &smallUnit);
+    Deck::setSeed(77u);
+    runTable(500000, &largeAlone, &largeUnit);
+    assert(std::fabs(largeUnit - 500000 * 0.5f * 0.004854187311f / 1.32f) < 1e-2f);
+    assert(std::fabs(smallUnit - 1000 * 0.5f * 0.004854187311f / 1.32f) < 1e-4f);
+    assert(largeAlone.second > smallAlone.second);
+
+    // Concurrent engines no longer see each other's wallet; each new thread
+    // seeds its generator from 77 just as the reseeded main thread did
+    std::thread small(runTable, 1000.0, &smallShared, &unused);
+    std::thread large(runTable, 500000.0, &largeShared, &unused);
+    small.join();
+    large.join();
+    Deck::clearSeed();
+    assert(smallShared == smallAlone);
+    assert(largeShared == largeAlone);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testTrueCountHistogramBinsAndMerge() {
+    std::cout << "\n--- Running testTrueCountHistogramBinsAndMerge ---" << std::endl;
+
+    TrueCountHistogram histogram(-2.0f, 2.0f);
+    assert(histogram.binCount() == 9 + 2);
+    // Same half-TC rounding the engine applies to a hand's count
+    for (float tc : {-2.0f, -1.3f, -0.25f, 0.0f, 0.26f, 0.74f, 1.75f, 2.0f}) {
+        const int bin = histogram.binIndex(tc);
+        assert(!histogram.isUnderflow(bin) && !histogram.isOverflow(bin));
+        assert(histogram.binTrueCount(bin) == std::round(tc * 2.0f) / 2.0f);
+    }
+    assert(histogram.isUnderflow(histogram.binIndex(-2.3f)));
+    assert(histogram.isOverflow(histogram.binIndex(40.0f)));
+    assert(histogram.getMinTrueCount() == -2.0f && histogram.getMaxTrueCount() == 2.0f);
+    // Neighbouring accumulators never share a cache line
+    assert(reinterpret_cast<const char*>(&histogram.bin(1)) - reinterpret_cast<const char*>(&histogram.bin(0)) >= 64);
+
+    // Merging two halves gives the same bins as recording everything in one
+    TrueCountHistogram whole(-2.0f, 2.0f), first(-2.0f, 2.0f), second(-2.0f, 2.0f);
+    for (int i = 0; i < 200; ++i) {
+        const float tc = static_cast<float>(i % 13) * 0.4f - 2.6f;
+        const double net = (i % 3 == 0) ? -1.0 : (i % 3 == 1 ? 1.5 : 0.0);
+        const double wagered = 1.0 + (i % 4);
+        whole.addResult(tc, net * wagered, wagered);
+        (i < 90 ? first : second).addResult(tc, net * wagered, wagered);
+    }
+    first.merge(second);
+    assert(first.occupiedBins() == whole.occupiedBins());
+    for (int bin = 0; bin < whole.binCount(); ++bin) {
+        assert(first.bin(bin).handsPlayed == whole.bin(bin).handsPlayed);
+        assert(std::fabs(first.bin(bin).totalPayout - whole.bin(bin).totalPayout) < 1e-9);
+        assert(std::fabs(first.bin(bin).getEV() - whole.bin(bin).getEV()) < 1e-9);
+        assert(std::fabs(first.bin(bin).getVariance() - whole.bin(bin).getVariance()) < 1e-9);
+    }
+
+    bool threw = false;
+    try {
+        first.merge(TrueCountHistogram());
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    first.clear();
+    assert(first.occupiedBins() == 0);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testScenarioMatcherMatchesAppliesTo() {
+    std::cout << "\n--- Running testScenarioMatcherMatchesAppliesTo ---" << std::endl;
+
+    MonteCarloScenario insurance{"Insurance", {Action::InsuranceAccept, Action::InsuranceDecline}, {{20, 11}, {12, 11}}, true, false, true};
+    MonteCarloScenario hitStand{"HitStand", {Action::Hit, Action::Stand}, {{16, 10}, {12, 2}}, false, false, false};
+    MonteCarloScenario splitStand{"SplitStand", {Action::Split, Action::Stand}, {{20, 5}, {20, 6}}, false, true, false};
+    MonteCarloScenario surrender{"Surrender", {Action::Surrender, Action::Hit}, {{16, 10}, {15, 10}}, false, false, false};
+    const std::vector<MonteCarloScenario> scenarios = {insurance, hitStand, splitStand, surrender};
+
+    const ScenarioMatcher matcher(scenarios);
+    assert(matcher.hasInsuranceScenarios());
+    for (int total = -1; total <= 22; ++total) {
+        for (int upcard = -1; upcard <= 12; ++upcard) {
+            for (int flags = 0; flags < 8; ++flags) {
+                const bool soft = flags & 1, pair = flags & 2, insurancePhase = flags & 4;
+                ScenarioMatcher::Mask expected = 0;
+                for (std::size_t id = 0; id < scenarios.size(); ++id) {
+                    if (scenarios[id].isInsuranceScenario == insurancePhase && scenarios[id].appliesTo(total, upcard, soft, pair)) {
+                        expected |= ScenarioMatcher::Mask{1} << id;
+                    }
+                }
+                assert(matcher.match(total, upcard, soft, pair, insurancePhase) == expected);
+            }
+        }
+    }
+    // Hard 16 vs 10 feeds two scenarios, visited in id order
+    ScenarioMatcher::Mask both = matcher.match(16, 10, false, false, false);
+    assert(ScenarioMatcher::firstId(both) == 1);
+    both &= both - 1;
+    assert(ScenarioMatcher::firstId(both) == 3);
+
+    assert(!ScenarioMatcher({hitStand}).hasInsuranceScenarios());
+    assert(ScenarioMatcher().match(16, 10, false, false, false) == 0);
+    bool threw = false;
+    try {
+        ScenarioMatcher(std::vector<MonteCarloScenario>(ScenarioMatcher::MAX_SCENARIOS + 1, hitStand));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testTreeReduceMatchesSequentialRun() {
+    std::cout << "\n--- Running testTreeReduceMatchesSequentialRun ---" << std::endl;
+
+    // Five parts fold to the same totals as a left-to-right merge
+    std::vector<TrueCountHistogram> parts(5, TrueCountHistogram(-2.0f, 2.0f));
+    TrueCountHistogram sequential(-2.0f, 2.0f);
+    for (int i = 0; i < 5; ++i) {
+        parts[i].addResult(0.5f * (i - 2), i - 1.0, 1.0 + i);
+        parts[i].addResult(1.0f, 2.0, 2.0);
+        sequential.merge(parts[i]);
+    }
+    const TrueCountHistogram& reduced = treeReduce(parts);
+    for (int bin = 0; bin < sequential.binCount(); ++bin) {
+        assert(reduced.bin(bin).handsPlayed == sequential.bin(bin).handsPlayed);
+        assert(std::fabs(reduced.bin(bin).totalPayout - sequential.bin(bin).totalPayout) < 1e-12);
+        assert(std::fabs(reduced.bin(bin).getEV() - sequential.bin(bin).getEV()) < 1e-12);
+        assert(std::fabs(reduced.bin(bin).getVariance() - sequential.bin(bin).getVariance()) < 1e-12);
+    }
+    std::vector<TrueCountHistogram> none;
+    bool threw = false;
+    try {
+        treeReduce(none);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Workers playing contiguous shoe ranges of one stream reduce to the sequential run
+    MonteCarloScenario hitStand{"Hit_vs_Stand", {Action::Hit, Action::Stand}, {{16, 10}, {12, 2}, {13, 2}}, false, false, false};
+    const std::uint64_t key = Deck::streamKey("tree-reduce");
+    auto run = [&](std::uint64_t firstShoe, std::uint64_t shoeCount) {
+        std::map<std::pair<int, int>, std::map<float, DecisionPoint>> EVresults;
+        BotPlayer robot(false, std::make_unique<HiLoStrategy>(2));
+        ShoePipeline shoes(2, key, shoeCount, firstShoe, 4);
+        Engine engine = EngineBuilder()
+                .setDeckSize(2)
+                .setDeck(Deck(2))
+                .setPenetrationThreshold(.75)
+                .enableMontiCarlo(true)
+                .setMonteCarloScenarios({hitStand})
+                .setEVActions(EVresults)
+                .build(&robot);
+        for (std::uint64_t i = 0; i < shoeCount; ++i) {
+            engine.loadShoe(shoes.next());
+            engine.runner();
+        }
+        return engine.getMonteCarloResults();
+    };
+    const FixedEngine whole = run(0, 90);
+    std::vector<FixedEngine> workers = {run(0, 30), run(30, 30), run(60, 30)};
+    const ScenarioTensor& expected = whole.getScenarioResults();
+    const ScenarioTensor& actual = treeReduce(workers).getScenarioResults();
+    assert(actual.sameLayout(expected));
+    int hands = 0;
+    for (const auto& cardValues : expected.trackedCells(0)) {
+        for (int bucket = 0; bucket < expected.bucketCount(); ++bucket) {
+            const DecisionPoint& want = expected.row(0, cardValues)[bucket];
+            const DecisionPoint& got = actual.row(0, cardValues)[bucket];
+            assert(got.hitStats.handsPlayed == want.hitStats.handsPlayed);
+            assert(got.standStats.handsPlayed == want.standStats.handsPlayed);
+            assert(std::fabs(got.hitStats.totalPayout - want.hitStats.totalPayout) < 1e-9);
+            assert(std::fabs(got.standStats.getEV() - want.standStats.getEV()) < 1e-9);
+            hands += want.standStats.handsPlayed;
+        }
+    }
+    assert(hands > 0);
+
+    std::cout << "PASSED" << std::endl;
+}
+
 int main() {
     std::cout << "=== STARTING BLACKJACK TESTS ===" << std::endl;
     
@@ -1649,6 +2755,21 @@ int main() {
     testSplitAcesOneCardLogic();
     testDoubleSoftHand();
     testDealerBustChain();
+    testShoeExhaustedMidRoundRefund();
+    testEngineReusedAcrossShoes();
+    testStaticRulesMatchRuntimeRules();
+    testTypedStrategyMatchesDynamicPath();
+    testNullTraceMatchesEventTrace();
+    testTwoSeatTableDealOrderAndCount();
+    testMultiCountTrackerLanesMatchStrategies();
+    testTaggedCountMatchesTagTables();
+    testDecisionTableMatchesStrategies();
+    testEngineEVperTCSpansUnbalancedCount();
+    testDeviationLoaderAppliesReportIndices();
+    testBetRampIsPerEngine();
+    testTrueCountHistogramBinsAndMerge();
+    testScenarioMatcherMatchesAppliesTo();
+    testTreeReduceMatchesSequentialRun();
     testBlackjackPush();
     testInsuranceDeclinedDealerBlackjackLoss();
     testInsuranceDeclinedMutualBlackjacksPush();
@@ -1689,6 +2810,14 @@ int main() {
     testInsuranceDecision();
     testFullDeckBalance();
     testDeckSeedReproducibility();
+    testShoeStreamReproducibility();
+    testLazyShuffleDeck();
+    testDeckComposition();
+    testDeckMarkRewind();
+    testShoePipelineOrder();
+    testPackedCardTables();
+    testHandIncrementalState();
+    testDealerKernelMatchesHandRules();
     testRiggedThreeHandFinalCount();
     testRiggedFourHandFinalCount();
     testRiggedFiveHandPositiveCount();
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <cmath>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include "FixedEngine.h"
@@ -1514,6 +1516,201 @@ void testInsuranceDeclinePlayerBlackjack() {
     std::cout << "PASSED" << std::endl;
 }
 
+// Scenario results land in the preallocated tensor and export like the old maps
+void testScenarioTensorRecordsMergesAndExports() {
+    std::cout << "Running testScenarioTensorRecordsMergesAndExports... ";
+
+    MonteCarloScenario scenario;
+    scenario.name = "Stand_20_vs_6";
+    scenario.actions = {Action::Stand};
+    scenario.cardValues = {{20, 6}};
+    GameConfig config;
+    config.monteCarloScenarios = {scenario};
+
+    // Dealer 16 draws the ten and busts; player 20 stands and wins
+    auto rollout = [](FixedEngine& engine, float trueCount, CardValues cardValues) {
+        Deck deck = Deck::createTestDeck({Card(Rank::Ten, Suit::Hearts)});
+        BotPlayer player(false, std::make_unique<NoStrategy>(0));
+        Hand dealer(Card(Rank::Six, Suit::Clubs), 1);
+        dealer.addCard(Card(Rank::Ten, Suit::Diamonds));
+        Hand user(std::make_pair(Card(Rank::Ten, Suit::Spades), Card(Rank::Ten, Suit::Hearts)), 1);
+        return engine.calculateEVForScenario(player, deck, dealer, user, trueCount, cardValues, 0);
+    };
+
+    const CardValues tracked{20, 6};
+    FixedEngine first({}, {}, config);
+    assert(rollout(first, 1.2f, tracked));
+    // A hand the scenario does not track is ignored
+    assert(rollout(first, 1.2f, {12, 6}));
+    FixedEngine second({}, {}, config);
+    assert(rollout(second, 1.2f, tracked));
+    assert(rollout(second, 100.0f, tracked));
+
+    FixedEngine total;
+    total.merge(first);
+    total.merge(second);
+    assert(total.getScenarioNames() == std::vector<std::string>{"Stand_20_vs_6"});
+
+    const ScenarioTensor& tensor = total.getScenarioResults();
+    assert(tensor.row(0, {12, 6}) == nullptr);
+    const DecisionPoint* row = tensor.row(0, tracked);
+    const DecisionPoint& atOne = row[tensor.bucketIndex(1.0f)];
+    assert(atOne.standStats.handsPlayed == 2);
+    assert(approxEqual(atOne.standStats.getEV(), 1.0));
+    assert(atOne.hitStats.handsPlayed == 0);
+    assert(row[tensor.bucketCount() - 1].standStats.handsPlayed == 1);
+
+    // Header plus one row per occupied in-range bucket; the overflow only goes to the binary export
+    std::ostringstream csv;
+    std::ostringstream dropped;
+    std::streambuf* cerrBuffer = std::cerr.rdbuf(dropped.rdbuf());
+    tensor.writeCSV(0, csv);
+    std::cerr.rdbuf(cerrBuffer);
+    assert(dropped.str() == "Stand_20_vs_6 20 vs 6: 1 hand(s) above 60.0 left out\n");
+    std::istringstream lines(csv.str());
+    std::string header, inRange, extra;
+    std::getline(lines, header);
+    std::getline(lines, inRange);
+    assert(header.rfind("UserValue,DealerValue,TrueCount,Hit EV", 0) == 0);
+    assert(inRange.rfind("20,6,1,0.000000,0.000000,1.000000,0.000000,", 0) == 0);
+    assert(inRange.substr(inRange.rfind(',') + 1) == "2");
+    assert(!std::getline(lines, extra));
+
+    std::stringstream binary;
+    tensor.writeBinary(binary);
+    ScenarioTensor restored = ScenarioTensor::readBinary(binary);
+    assert(restored.sameLayout(tensor));
+    assert(restored.row(0, tracked)[tensor.bucketIndex(1.0f)].standStats.handsPlayed == 2);
+    assert(restored.row(0, tracked)[tensor.bucketCount() - 1].standStats.handsPlayed == 1);
+
+    bool threw = false;
+    try {
+        std::istringstream truncated(binary.str().substr(0, 20));
+        ScenarioTensor::readBinary(truncated);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        restored.merge(ScenarioTensor());
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// Stands after any forced first action and counts how often it was asked
+class CountingStandPlayer : public Player {
+public:
+    int decisions = 0;
+    Action getAction(Hand&, Hand&, float) override { ++decisions; return Action::Stand; }
+    CountingStrategy* getStrategy() override { return nullptr; }
+    void updateDeckStrategySize(int) override {}
+    int getBetSize() override { return 1; }
+    void setUnitSize(float) override {}
+    void updateCount(Card) override {}
+    float getTrueCount() override { return 0.0f; }
+    bool shouldAcceptInsurance() override { return false; }
+};
+
+// Two scenarios comparing Hit at the same hand share one Hit rollout
+void testOverlappingScenariosShareRollouts() {
+    std::cout << "Running testOverlappingScenariosShareRollouts... ";
+
+    GameConfig config;
+    config.monteCarloScenarios = {
+        {"Hit_vs_Stand", {Action::Hit, Action::Stand}, {{12, 10}}, false, false, false},
+        {"Surrender_vs_Hit", {Action::Surrender, Action::Hit}, {{12, 10}}, false, false, false},
+    };
+    FixedEngine engine({}, {}, config);
+
+    // Hard 12 vs 17: the forced hit draws a two and stands on 14, the dealer stands
+    Deck deck = Deck::createTestDeck({Card(Rank::Two, Suit::Hearts)});
+    CountingStandPlayer player;
+    Hand dealer(Card(Rank::Ten, Suit::Clubs), 1);
+    dealer.addCard(Card(Rank::Seven, Suit::Diamonds));
+    Hand user(std::make_pair(Card(Rank::Ten, Suit::Spades), Card(Rank::Two, Suit::Clubs)), 1);
+
+    const CardValues cardValues{12, 10};
+    assert(engine.calculateEVForScenarios(player, deck, dealer, user, 0.0f, cardValues, 0b11));
+    assert(player.decisions == 1);
+
+    const ScenarioTensor& tensor = engine.getScenarioResults();
+    const int bucket = tensor.bucketIndex(0.0f);
+    const DecisionPoint& hitStand = tensor.row(0, cardValues)[bucket];
+    const DecisionPoint& surrenderHit = tensor.row(1, cardValues)[bucket];
+    assert(hitStand.hitStats.handsPlayed == 1 && approxEqual(hitStand.hitStats.getEV(), -1.0));
+    assert(surrenderHit.hitStats.handsPlayed == 1 && approxEqual(surrenderHit.hitStats.getEV(), -1.0));
+    assert(hitStand.standStats.handsPlayed == 1 && approxEqual(hitStand.standStats.getEV(), -1.0));
+    assert(hitStand.surrenderStats.handsPlayed == 0);
+    assert(surrenderHit.surrenderStats.handsPlayed == 1 && approxEqual(surrenderHit.surrenderStats.getEV(), -0.5));
+    assert(surrenderHit.standStats.handsPlayed == 0);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+// Each occurrence pairs the scenario's first action against its second
+void testPairedStatsTrackActionDifference() {
+    std::cout << "Running testPairedStatsTrackActionDifference... ";
+
+    // Streaming and merged halves agree with the differences computed directly
+    const std::vector<std::pair<double, double>> outcomes = {{1, -1}, {-1, -1}, {2, 1}, {-1, 0}, {1, 1}, {-2, -1}};
+    PairedStats streamed, firstHalf, secondHalf;
+    double sumDiff = 0.0;
+    for (std::size_t i = 0; i < outcomes.size(); ++i) {
+        streamed.addPair(outcomes[i].first, outcomes[i].second);
+        (i < 2 ? firstHalf : secondHalf).addPair(outcomes[i].first, outcomes[i].second);
+        sumDiff += outcomes[i].first - outcomes[i].second;
+    }
+    const double meanDiff = sumDiff / outcomes.size();
+    double squaredDiff = 0.0;
+    for (const auto& [a, b] : outcomes) {
+        squaredDiff += (a - b - meanDiff) * (a - b - meanDiff);
+    }
+    firstHalf.merge(secondHalf);
+    for (const PairedStats* stats : {&streamed, &firstHalf}) {
+        assert(stats->pairs == 6);
+        assert(approxEqual(stats->getDiffEV(), meanDiff));
+        assert(approxEqual(stats->getDiffVariance(), squaredDiff / outcomes.size()));
+        assert(approxEqual(stats->getDiffStdError(), std::sqrt(squaredDiff / outcomes.size() / outcomes.size())));
+    }
+
+    GameConfig config;
+    config.monteCarloScenarios = {{"Hit_vs_Stand", {Action::Hit, Action::Stand}, {{12, 10}}, false, false, false}};
+    FixedEngine engine({}, {}, config);
+    const CardValues cardValues{12, 10};
+
+    // Hard 12 vs 17: hitting a two loses like standing, hitting a nine wins
+    for (Rank draw : {Rank::Two, Rank::Nine}) {
+        Deck deck = Deck::createTestDeck({Card(draw, Suit::Hearts)});
+        CountingStandPlayer player;
+        Hand dealer(Card(Rank::Ten, Suit::Clubs), 1);
+        dealer.addCard(Card(Rank::Seven, Suit::Diamonds));
+        Hand user(std::make_pair(Card(Rank::Ten, Suit::Spades), Card(Rank::Two, Suit::Clubs)), 1);
+        assert(engine.calculateEVForScenario(player, deck, dealer, user, 0.0f, cardValues, 0));
+    }
+
+    const ScenarioTensor& tensor = engine.getScenarioResults();
+    const PairedStats& paired = tensor.row(0, cardValues)[tensor.bucketIndex(0.0f)].pairedStats;
+    assert(paired.pairs == 2);
+    assert(approxEqual(paired.getDiffEV(), 1.0));
+    assert(approxEqual(paired.getDiffVariance(), 1.0));
+    assert(approxEqual(paired.getCovariance(), 0.0));
+    assert(approxEqual(paired.getDiffStdError(), std::sqrt(0.5)));
+
+    std::ostringstream csv;
+    tensor.writeCSV(0, csv);
+    const std::string text = csv.str();
+    assert(text.find("Insurance Decline Variance,Paired Diff EV,Paired Diff Variance,Paired Covariance,Paired Diff Std Error,Paired Hands,Hands Played") != std::string::npos);
+    assert(text.find(",1.000000,1.000000,0.000000,0.707107,2,2\n") != std::string::npos);
+
+    std::cout << "PASSED" << std::endl;
+}
+
 int main() {
     std::cout << "\n=== FIXED ENGINE TESTS ===" << std::endl;
     
@@ -1570,6 +1767,9 @@ int main() {
     testInsuranceAcceptNoDealerBlackjack();
     testInsuranceDeclineDealerBlackjack();
     testInsuranceDeclinePlayerBlackjack();
+    testScenarioTensorRecordsMergesAndExports();
+    testOverlappingScenariosShareRollouts();
+    testPairedStatsTrackActionDifference();
     
     std::cout << "\nAll FixedEngine tests passed successfully!" << std::endl;
     return 0;